@@ -0,0 +1,128 @@
+// SimpleFS ölçüm programı: fs_backup, fs_read ve fs_scrub sürelerini tamponlu ve direct I/O
+// modunda, 1..N iş parçacığıyla ölçer. Her yapılandırma ayrı bir alt süreçte çalıştırılır;
+// böylece raporlanan en yüksek bellek kullanımı (max RSS) yalnızca o yapılandırmaya aittir.
+//
+// Kullanım: ./simplefs_bench [en_fazla_is_parcacigi] [tekrar]
+#include "fs.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+const int BENCH_FILES = 8;
+const int BENCH_FILE_SIZE = 1024 * 1024;
+const char* BENCH_BACKUP = "bench.bak";
+
+static double now_seconds() {
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+static std::string bench_name(int i) {
+    return "bench" + std::to_string(i);
+}
+
+// Ölçülecek dosyaları oluşturur; içerik her dosyada farklıdır.
+static int prepare_files() {
+    if (fs_format() < 0)
+        return -1;
+    std::vector<char> data(BENCH_FILE_SIZE);
+    for (int i = 0; i < BENCH_FILES; i++) {
+        for (int j = 0; j < BENCH_FILE_SIZE; j++)
+            data[j] = (char)((i * 131 + j * 7) & 0xff);
+        if (fs_create(bench_name(i).c_str()) < 0 ||
+            fs_write(bench_name(i).c_str(), data.data(), BENCH_FILE_SIZE) < 0)
+            return -1;
+    }
+    return fs_sync();
+}
+
+// Bir yapılandırmayı alt süreçte ölçer ve tek satır sonuç yazar.
+static int run_config(int direct, int threads, int reps) {
+    if (fs_set_direct_io(direct) < 0)
+        return 2;
+    if (fs_set_parallelism(threads) < 0)
+        return 1;
+
+    double total_mb = (double)BENCH_FILES * BENCH_FILE_SIZE / (1024 * 1024);
+    std::vector<char> buffer(BENCH_FILE_SIZE);
+
+    double t0 = now_seconds();
+    for (int r = 0; r < reps; r++)
+        if (fs_backup(BENCH_BACKUP) < 0)
+            return 1;
+    double backup_s = (now_seconds() - t0) / reps;
+
+    t0 = now_seconds();
+    for (int r = 0; r < reps; r++)
+        for (int i = 0; i < BENCH_FILES; i++)
+            if (fs_read(bench_name(i).c_str(), 0, BENCH_FILE_SIZE, buffer.data()) < 0)
+                return 1;
+    double read_s = (now_seconds() - t0) / reps;
+
+    t0 = now_seconds();
+    for (int r = 0; r < reps; r++)
+        if (fs_scrub() < 0)
+            return 1;
+    double scrub_s = (now_seconds() - t0) / reps;
+
+    printf("%-9s %3d  %10.1f %10.1f %10.1f", direct ? "direct" : "tamponlu", threads,
+           total_mb / backup_s, total_mb / read_s, total_mb / scrub_s);
+    fflush(stdout);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    int max_threads = argc > 1 ? atoi(argv[1]) : (int)std::thread::hardware_concurrency();
+    int reps = argc > 2 ? atoi(argv[2]) : 5;
+    if (max_threads < 1)
+        max_threads = 1;
+    if (reps < 1)
+        reps = 1;
+
+    if (prepare_files() < 0) {
+        fprintf(stderr, "bench: Dosyalar hazirlanamadi\n");
+        return 1;
+    }
+
+    printf("%d dosya x %d KB, %d tekrar (MB/s; max RSS alt surece aittir)\n",
+           BENCH_FILES, BENCH_FILE_SIZE / 1024, reps);
+    printf("%-9s %3s  %10s %10s %10s %10s\n", "mod", "thr", "backup", "read", "scrub", "maxRSS(KB)");
+    fflush(stdout);
+
+    for (int direct = 0; direct <= 1; direct++) {
+        for (int threads = 1; threads <= max_threads; threads++) {
+            pid_t pid = fork();
+            if (pid < 0) {
+                perror("bench: fork");
+                return 1;
+            }
+            if (pid == 0)
+                _exit(run_config(direct, threads, reps));
+
+            int status = 0;
+            struct rusage usage;
+            if (wait4(pid, &status, 0, &usage) < 0) {
+                perror("bench: wait4");
+                return 1;
+            }
+            int code = WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+            if (code == 2) {
+                printf("%-9s %3d  direct I/O bu dosya sisteminde acilamadi\n", "direct", threads);
+                break;
+            }
+            if (code != 0)
+                printf("%-9s %3d  olcum basarisiz\n", direct ? "direct" : "tamponlu", threads);
+            else
+                printf(" %10ld\n", usage.ru_maxrss);
+            fflush(stdout);
+        }
+    }
+    remove(BENCH_BACKUP);
+    return 0;
+}
@@ -0,0 +1,56 @@
+#ifndef DISK_H
+#define DISK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include <sys/types.h>
+
+// Disk imajlarına erişen tek katman. Tamponlu modda doğrudan pread/pwrite kullanılır;
+// direct modda dosyalar O_DIRECT ile açılır ve her aktarım hizalı havuz tamponlarından geçer.
+//
+// Disk bir veya daha fazla imajdan oluşan bir birimdir (varsayılan: yalnızca disk.sim).
+// fs.cpp her zaman tek bir mantıksal adres alanı görür; birden çok üyede veri alanı
+// stripe_unit boyutlu parçalar halinde üyelere dağıtılır ve aktarımlar üye başına bölünür.
+
+extern const char* DISK_FILENAME;
+
+// Birimin imajlarını ve şerit boyutunu ayarlar (sonraki disk_open çağrılarını etkiler).
+// Şerit boyutu 4096'nın katı olmalıdır.
+int disk_set_volume(const std::vector<std::string>& images, uint32_t stripe_unit);
+void disk_get_volume(std::vector<std::string>& images, uint32_t& stripe_unit);
+int disk_member_count();
+uint32_t disk_stripe_unit();
+// Birimin mantıksal boyutu (metadata alanı + tüm üyelerin veri alanları)
+uint32_t disk_capacity();
+
+// Birimin tüm üyelerini açar ve bir tanıtıcı döner; direct moddaysa O_DIRECT eklenir
+// (O_WRONLY, okuma-değiştirme-yazma için O_RDWR'a çevrilir). Tanıtıcı disk_close ile kapatılır.
+int disk_open(int flags, mode_t mode = 0666);
+int disk_close(int fd);
+
+// Tam olarak size byte okur/yazar. fd O_DIRECT ile açılmışsa hizalanmamış aralıklar
+// hizalı bloklar üzerinden (yazmada okuma-değiştirme-yazma ile) işlenir. Aşağıdaki
+// fonksiyonlar disk_open tanıtıcılarıyla birlikte sıradan dosya fd'leriyle de çalışır.
+bool disk_pread(int fd, char* buffer, size_t size, off_t offset);
+bool disk_pwrite(int fd, const char* buffer, size_t size, off_t offset);
+
+// Mantıksal boyut, boyutlandırma, delik açma ve veri içeren (delik olmayan) aralıklar
+off_t disk_size(int fd);
+int disk_truncate(int fd, off_t size);
+int disk_punch(int fd, off_t start, off_t size);
+void disk_data_segments(int fd, off_t size, std::vector<std::pair<off_t, off_t>>& segments);
+
+// İlk üye dışındaki üyelerin başındaki etiketleri yazar/doğrular (tek imajda bir şey yapmaz).
+int disk_write_labels(int fd, uint32_t volume_id);
+int disk_check_labels(int fd, uint32_t volume_id);
+
+// Direct modu açar/kapatır. Dosya sistemi O_DIRECT desteklemiyorsa -1 döner ve
+// tamponlu modda kalınır.
+int disk_set_direct(bool enabled);
+bool disk_direct();
+size_t disk_alignment();
+
+#endif // DISK_H
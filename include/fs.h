@@ -4,21 +4,114 @@
 #include <cstdint>
 #include <ctime>
 
-const int METADATA_SIZE = 65536;               // Metadata alanı için ayrılmış alan
-const int DISK_SIZE = 10 * 1024 * 1024;        // 10 MB disk
+const int METADATA_SIZE = 128 * 1024;          // Metadata alanı için ayrılmış alan
+const int DISK_SIZE = 10 * 1024 * 1024;        // 10 MB disk (birimde her imajın boyutu)
 const int BLOCK_SIZE = 512;                    // Sabit blok boyutu
-const int MAX_FILES = 100;                     // Maksimum dosya sayısı
+const int MAX_FILES = 100;                     // Maksimum dosya sayısı (dizinler dahil)
+const int MAX_NAME = 100;                      // Yol bileşeni uzunluğu (sonlandırıcı dahil)
+const int DIR_HASH_SIZE = 128;                 // Dizin hash tablosundaki kova sayısı
+const int MAX_SNAPSHOTS = 4;                   // Metadata alanında saklanan snapshot sayısı
+const int MAX_SNAPSHOT_NAME = 32;              // Snapshot ismi uzunluğu (sonlandırıcı dahil)
+const int HASH_SIZE = 32;                      // İçerik özeti (SHA-256) boyutu
+const int MAX_VOLUME_MEMBERS = 8;              // Bir birimdeki en fazla imaj sayısı
+const uint32_t DEFAULT_STRIPE_UNIT = 64 * 1024; // Varsayılan şerit boyutu
+
+const uint32_t FS_MAGIC = 0x53465331;          // "SFS1"
+const uint32_t FS_VERSION = 5;                 // Disk düzeni sürümü
+
+const uint8_t FS_TYPE_FILE = 0;                // Normal dosya
+const uint8_t FS_TYPE_DIR = 1;                 // Dizin
+const int16_t FS_ROOT = -2;                    // Kök dizinin (sanal) indeksi; -1 "bulunamadi" demektir
 
 #pragma pack(push, 1)
 struct FileMetadata {
     uint8_t valid;         // 0: boş, 1: dolu
-    char name[100];        // Dosya ismi
+    char name[MAX_NAME];   // Yol bileşeni (üst dizine göre isim)
     uint32_t size;         // Dosya boyutu (byte)
     uint32_t start;        // Veri alanındaki başlangıç offseti
     time_t creationTime;   // Dosya oluşturulma zamanı
+    uint8_t type;          // FS_TYPE_FILE / FS_TYPE_DIR
+    int16_t parent;        // Üst dizinin indeksi (FS_ROOT: kök)
+    int16_t hash_next;     // Aynı hash kovasındaki sonraki girdi (-1: yok)
+    uint8_t content_hash_valid;            // 0: içerik değişti, özet yeniden hesaplanmalı
+    uint8_t content_hash[HASH_SIZE];       // İçeriğin SHA-256 özeti (fs_diff)
+};
+
+struct SnapshotInfo {
+    uint8_t valid;
+    char name[MAX_SNAPSHOT_NAME];
+    time_t creationTime;
+};
+
+// Diskin başındaki süper blok; hemen ardından MAX_FILES adet FileMetadata, onun ardından
+// MAX_SNAPSHOTS adet SnapshotTable gelir.
+struct SuperBlock {
+    uint32_t magic;                   // FS_MAGIC
+    uint32_t version;                 // FS_VERSION
+    int32_t file_count;               // Dolu metadata girdisi sayısı
+    uint32_t generation;              // İsim alanı her değiştiğinde artar
+    int16_t dir_hash[DIR_HASH_SIZE];  // (parent, isim) hash kovası -> ilk girdi (-1: boş)
+    uint32_t snapshot_end;            // Snapshot'ların başvurduğu verinin bittiği offset
+    SnapshotInfo snapshots[MAX_SNAPSHOTS];
+    uint32_t volume_id;               // Formatlamada belirlenir, diğer imajların etiketinde de bulunur
+    uint16_t member_count;            // Birimi oluşturan imaj sayısı
+    uint32_t stripe_unit;             // Veri alanının imajlara dağıtıldığı parça boyutu
+};
+
+// Snapshot anındaki dondurulmuş isim alanı. Veri blokları canlı dosyalarla paylaşılır;
+// yazma işlemleri veriyi hiçbir zaman yerinde değiştirmediği için paylaşım copy-on-write'tır.
+struct SnapshotTable {
+    int32_t file_count;
+    int16_t dir_hash[DIR_HASH_SIZE];
+    FileMetadata files[MAX_FILES];
 };
 #pragma pack(pop)
 
+static_assert(sizeof(SuperBlock) + sizeof(FileMetadata) * MAX_FILES + sizeof(SnapshotTable) * MAX_SNAPSHOTS <= METADATA_SIZE,
+              "Metadata alani yetersiz");
+
+// fs_readdir tarafından doldurulan dizin girdisi
+struct FsDirEntry {
+    char name[MAX_NAME];
+    uint8_t type;
+    uint32_t size;
+};
+
+// fs_list'in geri çağırma fonksiyonuna verdiği girdi (path yalnızca çağrı süresince geçerlidir)
+struct FsListEntry {
+    const char* path;      // Kökten tam yol, ör. "/dizin/dosya"
+    uint8_t type;
+    uint32_t size;
+};
+
+// Sıfırdan farklı bir değer dönerse listeleme durur. Sayfa, geri çağırmalardan önce
+// toplanır; geri çağırma diğer fs_* fonksiyonlarını çağırabilir, yaptığı değişiklikler
+// o sayfaya yansımaz.
+typedef int (*fs_list_cb)(const FsListEntry* entry, void* ctx);
+
+// fs_list filtreleri; NULL alanlar yok sayılır. Yollar '/' ile başlamıyorsa başına eklenir.
+struct FsListOptions {
+    const char* prefix;       // Yalnızca bu önekle başlayan yollar
+    const char* range_start;  // path >= range_start
+    const char* range_end;    // path < range_end
+    const char* cursor;       // Önceki sayfanın next_cursor değeri; bu yoldan sonrası döner
+    int limit;                // Sayfa boyutu (0: sınırsız)
+};
+
+// fs_snapshot_list tarafından doldurulan snapshot bilgisi
+struct FsSnapshotInfo {
+    char name[MAX_SNAPSHOT_NAME];
+    time_t creationTime;
+    int file_count;
+    uint32_t exclusive_bytes;  // Yalnızca bu snapshot'ın tuttuğu (canlı veriden ayrışmış) veri
+};
+
+// fs_diff_ranges'in raporladığı farklı byte aralığı: [start, end)
+struct FsDiffRange {
+    uint32_t start;
+    uint32_t end;
+};
+
 /// Fonksiyon prototipleri ///
 int fs_create(const char* filename);
 int fs_delete(const char* filename);
@@ -33,12 +126,34 @@ int fs_append(const char* filename, const char* data, int size);
 int fs_truncate(const char* filename, int new_size);
 int fs_copy(const char* src_filename, const char* dest_filename);
 int fs_mv(const char* old_path, const char* new_path);
+int fs_mkdir(const char* path);
+int fs_rmdir(const char* path);
+int fs_readdir(const char* path, FsDirEntry* entries, int max_entries);
+int fs_list(const FsListOptions* opts, fs_list_cb cb, void* ctx, char* next_cursor, int cursor_size);
 int fs_defragment();
 int fs_check_integrity();
 int fs_backup(const char* backup_filename);
 int fs_restore(const char* backup_filename);
 int fs_cat(const char* filename);
 int fs_diff(const char* file1, const char* file2);
+int fs_diff_ranges(const char* file1, const char* file2, FsDiffRange* ranges, int max_ranges);
 int fs_log(const char* operation);
+int fs_copy_many(const char* const src_filenames[], const char* const dest_filenames[], int count);
+int fs_scrub();
+int fs_set_parallelism(int threads);
+int fs_snapshot_create(const char* name);
+int fs_snapshot_list(FsSnapshotInfo* infos, int max_infos);
+int fs_snapshot_read(const char* snapshot, const char* filename, int offset, int size, char* buffer);
+int fs_snapshot_rollback(const char* name);
+int fs_snapshot_delete(const char* name);
+int fs_set_direct_io(int enabled);
+int fs_get_direct_io();
+int fs_get_parallelism();
+int fs_format_volume(const char* const images[], int count, int stripe_unit);
+int fs_mount(const char* const images[], int count);
+int fs_fsync(const char* filename);
+int fs_sync();
+int fs_set_shared_metadata(int enabled);
+int fs_get_shared_metadata();
 
 #endif // FS_H
@@ -0,0 +1,73 @@
+#ifndef FS_ASYNC_H
+#define FS_ASYNC_H
+
+#include <cstdint>
+#include <future>
+
+// Asenkron işlem türleri; her biri aynı isimli senkron fs_* fonksiyonunu çalıştırır.
+enum FsOp {
+    FS_OP_READ,    // fs_read(filename, offset, size, buffer)
+    FS_OP_WRITE,   // fs_write(filename, buffer, size)
+    FS_OP_APPEND,  // fs_append(filename, buffer, size)
+    FS_OP_COPY     // fs_copy(filename, filename2)
+};
+
+struct FsRequest;
+typedef void (*fs_completion_cb)(FsRequest* req);
+
+// fs_submit ile kuyruğa verilen istek. İstek, isimler ve tampon tamamlanana kadar
+// çağıranın sahipliğinde kalır ve geçerli olmalıdır.
+struct FsRequest {
+    FsOp op;
+    const char* filename;
+    const char* filename2;      // Yalnızca FS_OP_COPY: hedef dosya
+    char* buffer;               // Okuma: hedef tampon, yazma/ekleme: kaynak veri
+    int offset;
+    int size;
+    fs_completion_cb callback;  // NULL değilse işçi iş parçacığında çağrılır,
+                                // NULL ise istek tamamlanma kuyruğuna eklenir (fs_reap)
+    void* user_data;
+    int result;                 // Senkron fonksiyonun dönüş değeri
+    uint64_t submit_ns;         // Kütüphane tarafından doldurulur
+    uint64_t complete_ns;
+};
+
+// Kuyruk istatistikleri (fs_async_stats)
+struct FsAsyncStats {
+    uint64_t submitted;
+    uint64_t completed;
+    int queue_depth;            // Henüz tamamlanmamış istek sayısı
+    int max_queue_depth;
+    uint64_t batches;           // İşçilerin aldığı toplu iş sayısı
+    double avg_latency_us;      // Gönderimden tamamlanmaya ortalama süre
+    double max_latency_us;
+};
+
+// İşçi havuzunu başlatır (workers <= 0: donanım iş parçacığı sayısı). İlk fs_submit
+// çağrısı havuzu otomatik başlatır; açıkça çağırmak yalnızca işçi sayısını seçmek içindir.
+int fs_async_init(int workers);
+// Bekleyen tüm istekleri tamamlar ve işçileri durdurur.
+void fs_async_shutdown();
+
+// İstekleri kuyruğa ekler, eklenen istek sayısını döner.
+//
+// Sıralama: aynı dosyaya dokunan istekler (kopyada kaynak ve hedef) gönderim sırasıyla
+// çalışır; bir okuma, kendisinden önce gönderilen yazma/eklemenin sonucunu görür. Farklı
+// dosyalara ait istekler farklı işçilerde paralel ve herhangi bir sırayla tamamlanabilir;
+// ardışık okumalar disk konumuna göre yeniden sıralanabilir. Dosyalar yol metniyle
+// eşleştirilir ("/a//b" ile "a/b" aynıdır). Tamamlanma kuyruğundaki sıra garanti değildir.
+int fs_submit(FsRequest* const reqs[], int count);
+// Tamamlanma kuyruğundan en az min_complete, en fazla max istek alır; alınan sayıyı döner.
+int fs_reap(FsRequest* completed[], int max, int min_complete);
+
+void fs_async_stats(FsAsyncStats* stats);
+void fs_async_reset_stats();
+
+// std::future döndüren kısayollar. Yazma/ekleme verisi çağrı sırasında kopyalanır;
+// okuma tamponu ise future tamamlanana kadar geçerli kalmalıdır.
+std::future<int> fs_read_async(const char* filename, int offset, int size, char* buffer);
+std::future<int> fs_write_async(const char* filename, const char* data, int size);
+std::future<int> fs_append_async(const char* filename, const char* data, int size);
+std::future<int> fs_copy_async(const char* src_filename, const char* dest_filename);
+
+#endif // FS_ASYNC_H
@@ -0,0 +1,36 @@
+#ifndef FS_INTERNAL_H
+#define FS_INTERNAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Kütüphane içi yardımcılar; uygulamalar fs.h'yi kullanmalıdır.
+
+// Verilen dosyaların veri alanındaki mutlak disk offsetlerini tek metadata okumasıyla
+// hesaplar. Bulunamayan dosyalar için UINT32_MAX yazılır.
+void fs_data_offsets(const char* const filenames[], const int offsets[], uint32_t out[], int count);
+
+// Görevleri paylaşılan iş çalan havuzda çalıştırır ve hepsi bitene kadar bekler.
+// Çağıran iş parçacığı da görev çalıştırır; iç içe çağrılar güvenlidir.
+void fs_parallel_run(const std::vector<std::function<void()>>& tasks);
+
+// a ve b'deki ilk farklı (fs_mismatch) veya ilk eşit (fs_match) byte'ın indeksi; yoksa size.
+// Çalışma anında AVX2/SSE2/skaler sürümlerden uygun olanı kullanılır.
+size_t fs_mismatch(const char* a, const char* b, size_t size);
+size_t fs_match(const char* a, const char* b, size_t size);
+
+// Dosya içerik özetleri için SHA-256
+struct Sha256 {
+    uint32_t state[8];
+    uint64_t length;
+    uint8_t block[64];
+    size_t used;
+};
+
+void sha256_init(Sha256* ctx);
+void sha256_update(Sha256* ctx, const void* data, size_t size);
+void sha256_final(Sha256* ctx, uint8_t out[32]);
+
+#endif // FS_INTERNAL_H
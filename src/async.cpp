@@ -0,0 +1,341 @@
+#include "fs.h"
+#include "fs_async.h"
+#include "fs_internal.h"
+#include <cstdlib>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+// İşçilerin kuyruktan tek seferde aldığı en fazla istek sayısı
+const size_t ASYNC_BATCH_MAX = 32;
+
+static std::mutex queue_mutex;
+static std::condition_variable queue_cv;
+static std::deque<FsRequest*> pending;
+static std::vector<std::thread> workers;
+static bool stopping = false;
+// İşçilerde çalışan isteklerin dokunduğu dosyalar -> istek sayısı (queue_mutex ile korunur)
+static std::map<std::string, int> busy_files;
+
+static std::mutex completion_mutex;
+static std::condition_variable completion_cv;
+static std::deque<FsRequest*> completions;
+
+// queue_mutex ile korunur
+static FsAsyncStats stats;
+static uint64_t total_latency_ns = 0;
+static uint64_t max_latency_ns = 0;
+
+static uint64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Dosya yolunu karşılaştırma için normalize eder ("/a//b" ve "a/b" aynı dosyadır).
+static std::string file_key(const char* path) {
+    std::string key;
+    for (const char* p = path; *p; p++) {
+        if (*p == '/' && (key.empty() || key.back() == '/'))
+            continue;
+        key += *p;
+    }
+    if (!key.empty() && key.back() == '/')
+        key.pop_back();
+    return key;
+}
+
+static std::vector<std::string> request_files(const FsRequest* req) {
+    std::vector<std::string> files(1, file_key(req->filename));
+    if (req->op == FS_OP_COPY)
+        files.push_back(file_key(req->filename2));
+    return files;
+}
+
+// queue_mutex tutulurken kuyruktan bir toplu iş alır. Aynı dosyaya dokunan istekler
+// gönderim sırasıyla çalışmalıdır: başka bir işçide çalışan veya kuyrukta atlanan daha
+// eski bir istekle dosya paylaşan istek alınmaz. Toplu iş içindeki sıra korunduğu için
+// aynı toplu işe düşen istekler birbirini engellemez.
+static void take_batch(std::vector<FsRequest*>& batch) {
+    std::set<std::string> blocked, taken;
+    for (auto it = pending.begin(); it != pending.end() && batch.size() < ASYNC_BATCH_MAX; ) {
+        std::vector<std::string> files = request_files(*it);
+        bool ready = true;
+        for (size_t i = 0; i < files.size(); i++) {
+            if (blocked.count(files[i]) || (busy_files.count(files[i]) && !taken.count(files[i])))
+                ready = false;
+        }
+        if (!ready) {
+            blocked.insert(files.begin(), files.end());
+            ++it;
+            continue;
+        }
+        taken.insert(files.begin(), files.end());
+        batch.push_back(*it);
+        it = pending.erase(it);
+    }
+    for (size_t i = 0; i < batch.size(); i++) {
+        std::vector<std::string> files = request_files(batch[i]);
+        for (size_t j = 0; j < files.size(); j++)
+            busy_files[files[j]]++;
+    }
+}
+
+// Toplu işi disk konumuna göre sıralar. Yalnızca arada yazma olmayan ardışık okumalar
+// kendi aralarında artan offset sırasına dizilir; yazan işlemler yerinde kalır, böylece
+// bir okuma kendisinden önce gönderilen yazmanın önüne geçmez.
+static void order_batch(std::vector<FsRequest*>& batch) {
+    std::vector<const char*> names;
+    std::vector<int> offsets;
+    for (size_t i = 0; i < batch.size(); i++) {
+        names.push_back(batch[i]->filename);
+        offsets.push_back(batch[i]->op == FS_OP_READ ? batch[i]->offset : 0);
+    }
+    std::vector<uint32_t> keys(batch.size());
+    fs_data_offsets(names.data(), offsets.data(), keys.data(), (int)batch.size());
+    std::vector<std::pair<uint32_t, FsRequest*>> ordered;
+    for (size_t i = 0; i < batch.size(); i++)
+        ordered.push_back(std::make_pair(keys[i], batch[i]));
+    for (size_t begin = 0; begin < ordered.size(); ) {
+        if (ordered[begin].second->op != FS_OP_READ) {
+            begin++;
+            continue;
+        }
+        size_t end = begin;
+        while (end < ordered.size() && ordered[end].second->op == FS_OP_READ)
+            end++;
+        std::stable_sort(ordered.begin() + begin, ordered.begin() + end,
+                         [](const std::pair<uint32_t, FsRequest*>& a, const std::pair<uint32_t, FsRequest*>& b) {
+            return a.first < b.first;
+        });
+        begin = end;
+    }
+    for (size_t i = 0; i < batch.size(); i++)
+        batch[i] = ordered[i].second;
+}
+
+static void execute(FsRequest* req) {
+    switch (req->op) {
+        case FS_OP_READ:
+            req->result = fs_read(req->filename, req->offset, req->size, req->buffer);
+            break;
+        case FS_OP_WRITE:
+            req->result = fs_write(req->filename, req->buffer, req->size);
+            break;
+        case FS_OP_APPEND:
+            req->result = fs_append(req->filename, req->buffer, req->size);
+            break;
+        case FS_OP_COPY:
+            req->result = fs_copy(req->filename, req->filename2);
+            break;
+        default:
+            req->result = -1;
+            break;
+    }
+}
+
+static void complete(FsRequest* req) {
+    req->complete_ns = now_ns();
+    uint64_t latency = req->complete_ns - req->submit_ns;
+    bool released = false;
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        std::vector<std::string> files = request_files(req);
+        for (size_t i = 0; i < files.size(); i++) {
+            auto it = busy_files.find(files[i]);
+            if (--it->second == 0) {
+                busy_files.erase(it);
+                released = true;
+            }
+        }
+        stats.completed++;
+        stats.queue_depth--;
+        total_latency_ns += latency;
+        if (latency > max_latency_ns)
+            max_latency_ns = latency;
+    }
+    // Serbest kalan dosyayı bekleyen istekler başka işçilerce alınabilir.
+    if (released)
+        queue_cv.notify_all();
+    if (req->callback != NULL) {
+        req->callback(req);
+    } else {
+        std::lock_guard<std::mutex> lock(completion_mutex);
+        completions.push_back(req);
+        completion_cv.notify_all();
+    }
+}
+
+static void worker_main() {
+    std::vector<FsRequest*> batch;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            while (true) {
+                take_batch(batch);
+                if (!batch.empty())
+                    break;
+                if (stopping && pending.empty())
+                    return;
+                queue_cv.wait(lock);
+            }
+            stats.batches++;
+        }
+        if (batch.size() > 1)
+            order_batch(batch);
+        for (size_t i = 0; i < batch.size(); i++) {
+            execute(batch[i]);
+            complete(batch[i]);
+        }
+        batch.clear();
+    }
+}
+
+// fs_async_init: İşçi havuzunu başlatır; havuz zaten çalışıyorsa bir şey yapmaz.
+int fs_async_init(int count) {
+    static bool atexit_registered = false;
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    if (!workers.empty())
+        return 0;
+    if (count <= 0)
+        count = std::max(2u, std::thread::hardware_concurrency());
+    if (!atexit_registered) {
+        atexit(fs_async_shutdown);
+        atexit_registered = true;
+    }
+    stopping = false;
+    for (int i = 0; i < count; i++)
+        workers.push_back(std::thread(worker_main));
+    return 0;
+}
+
+// fs_async_shutdown: Kuyruktaki istekler bitene kadar bekler ve işçileri durdurur.
+void fs_async_shutdown() {
+    std::vector<std::thread> joining;
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        stopping = true;
+        joining.swap(workers);
+    }
+    queue_cv.notify_all();
+    for (size_t i = 0; i < joining.size(); i++)
+        joining[i].join();
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    stopping = false;
+}
+
+// fs_submit: İstekleri kuyruğa ekler.
+int fs_submit(FsRequest* const reqs[], int count) {
+    if (fs_async_init(0) < 0)
+        return -1;
+    uint64_t now = now_ns();
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        for (int i = 0; i < count; i++) {
+            reqs[i]->submit_ns = now;
+            reqs[i]->complete_ns = 0;
+            pending.push_back(reqs[i]);
+        }
+        stats.submitted += count;
+        stats.queue_depth += count;
+        if (stats.queue_depth > stats.max_queue_depth)
+            stats.max_queue_depth = stats.queue_depth;
+    }
+    queue_cv.notify_all();
+    return count;
+}
+
+// fs_reap: Tamamlanmış istekleri tamamlanma kuyruğundan alır.
+int fs_reap(FsRequest* completed[], int max, int min_complete) {
+    std::unique_lock<std::mutex> lock(completion_mutex);
+    completion_cv.wait(lock, [min_complete] { return (int)completions.size() >= min_complete; });
+    int count = 0;
+    while (count < max && !completions.empty()) {
+        completed[count++] = completions.front();
+        completions.pop_front();
+    }
+    return count;
+}
+
+void fs_async_stats(FsAsyncStats* out) {
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    *out = stats;
+    out->avg_latency_us = stats.completed ? total_latency_ns / 1000.0 / stats.completed : 0.0;
+    out->max_latency_us = max_latency_ns / 1000.0;
+}
+
+void fs_async_reset_stats() {
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    int depth = stats.queue_depth;
+    stats = FsAsyncStats();
+    stats.queue_depth = depth;
+    stats.max_queue_depth = depth;
+    total_latency_ns = 0;
+    max_latency_ns = 0;
+}
+
+//-------------------------
+// std::future kısayolları
+//-------------------------
+
+// İsimleri ve yazılacak veriyi istek tamamlanana kadar saklayan sarmalayıcı
+struct AsyncCall {
+    FsRequest req;
+    std::promise<int> promise;
+    std::string name;
+    std::string name2;
+    std::vector<char> data;
+};
+
+static void resolve_call(FsRequest* req) {
+    AsyncCall* call = static_cast<AsyncCall*>(req->user_data);
+    call->promise.set_value(req->result);
+    delete call;
+}
+
+static std::future<int> submit_call(FsOp op, const char* filename, const char* filename2,
+                                    char* buffer, const char* data, int offset, int size) {
+    AsyncCall* call = new AsyncCall();
+    call->name = filename;
+    if (filename2 != NULL)
+        call->name2 = filename2;
+    if (data != NULL && size > 0) {
+        call->data.assign(data, data + size);
+        buffer = call->data.data();
+    }
+    call->req = FsRequest();
+    call->req.op = op;
+    call->req.filename = call->name.c_str();
+    call->req.filename2 = call->name2.c_str();
+    call->req.buffer = buffer;
+    call->req.offset = offset;
+    call->req.size = size;
+    call->req.callback = resolve_call;
+    call->req.user_data = call;
+    std::future<int> result = call->promise.get_future();
+    FsRequest* req = &call->req;
+    fs_submit(&req, 1);
+    return result;
+}
+
+std::future<int> fs_read_async(const char* filename, int offset, int size, char* buffer) {
+    return submit_call(FS_OP_READ, filename, NULL, buffer, NULL, offset, size);
+}
+
+std::future<int> fs_write_async(const char* filename, const char* data, int size) {
+    return submit_call(FS_OP_WRITE, filename, NULL, NULL, data, 0, size);
+}
+
+std::future<int> fs_append_async(const char* filename, const char* data, int size) {
+    return submit_call(FS_OP_APPEND, filename, NULL, NULL, data, 0, size);
+}
+
+std::future<int> fs_copy_async(const char* src_filename, const char* dest_filename) {
+    return submit_call(FS_OP_COPY, src_filename, dest_filename, NULL, NULL, 0, 0);
+}
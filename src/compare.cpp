@@ -0,0 +1,83 @@
+#include "fs_internal.h"
+#include <cstring>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define FS_X86_SIMD 1
+#endif
+
+// fs_diff'in karşılaştırma çekirdeği. x86'da çalışma anında AVX2 veya SSE2 sürümü seçilir;
+// diğer mimarilerde 8 byte'lık kelimelerle çalışan skaler sürüm kullanılır.
+// find_equal true ise ilk eşit byte, false ise ilk farklı byte aranır.
+
+typedef size_t (*scan_fn)(const char* a, const char* b, size_t size, bool find_equal);
+
+static size_t scan_scalar(const char* a, const char* b, size_t size, bool find_equal) {
+    size_t i = 0;
+    if (!find_equal) {
+        // Farklılık aranırken eşit kelimeler toplu olarak atlanır.
+        for (; i + 8 <= size; i += 8) {
+            uint64_t x, y;
+            memcpy(&x, a + i, 8);
+            memcpy(&y, b + i, 8);
+            if (x != y)
+                break;
+        }
+    }
+    for (; i < size; i++) {
+        if ((a[i] == b[i]) == find_equal)
+            return i;
+    }
+    return size;
+}
+
+#ifdef FS_X86_SIMD
+static size_t scan_sse2(const char* a, const char* b, size_t size, bool find_equal) {
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i y = _mm_loadu_si128((const __m128i*)(b + i));
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(x, y));
+        if (!find_equal)
+            mask = ~mask & 0xFFFF;
+        if (mask != 0)
+            return i + __builtin_ctz(mask);
+    }
+    return i + scan_scalar(a + i, b + i, size - i, find_equal);
+}
+
+__attribute__((target("avx2")))
+static size_t scan_avx2(const char* a, const char* b, size_t size, bool find_equal) {
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i*)(b + i));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y));
+        if (!find_equal)
+            mask = ~mask;
+        if (mask != 0)
+            return i + __builtin_ctz(mask);
+    }
+    return i + scan_sse2(a + i, b + i, size - i, find_equal);
+}
+#endif
+
+static scan_fn select_scan() {
+#ifdef FS_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return scan_avx2;
+    if (__builtin_cpu_supports("sse2"))
+        return scan_sse2;
+#endif
+    return scan_scalar;
+}
+
+static const scan_fn scan = select_scan();
+
+size_t fs_mismatch(const char* a, const char* b, size_t size) {
+    return scan(a, b, size, false);
+}
+
+size_t fs_match(const char* a, const char* b, size_t size) {
+    return scan(a, b, size, true);
+}
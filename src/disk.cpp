@@ -0,0 +1,656 @@
+#include "fs.h"
+#include "fs_internal.h"
+#include "disk.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+
+const char* DISK_FILENAME = "disk.sim";
+
+// Direct modda tek seferde aktarılan en büyük hizalı parça ve havuzda tutulan tampon sayısı
+const size_t DIRECT_BUFFER_SIZE = 1024 * 1024;
+const size_t DIRECT_POOL_MAX = 16;
+// Okuma-değiştirme-yazma yapılan sınır bloklarını koruyan kilit sayısı
+const int BLOCK_LOCKS = 64;
+
+static std::atomic<bool> direct_mode(false);
+static size_t alignment = BLOCK_SIZE;
+
+static std::mutex pool_mutex;
+static std::vector<char*> free_buffers;
+static std::mutex block_locks[BLOCK_LOCKS];
+
+// Birim düzeni: metadata alanı ([0, METADATA_SIZE)) yalnızca ilk üyede, şeritlenmeden tutulur.
+// Veri alanı stripe_unit boyutlu parçalar halinde üyelere sırayla dağıtılır; her üyede
+// parçalar METADATA_SIZE offsetinden başlar. Diğer üyelerin ilk bloğunda üye etiketi bulunur.
+#pragma pack(push, 1)
+struct MemberLabel {
+    uint32_t magic;        // MEMBER_MAGIC
+    uint32_t volume_id;    // SuperBlock::volume_id
+    uint16_t index;        // Üyenin birimdeki sırası
+    uint16_t count;        // Birimdeki üye sayısı
+    uint32_t stripe_unit;
+};
+#pragma pack(pop)
+
+const uint32_t MEMBER_MAGIC = 0x53465342;      // "SFSB"
+
+// Açık bir birim: tanıtıcı ilk üyenin fd'sidir, düzen açılış anında sabitlenir.
+struct Volume {
+    std::vector<int> fds;
+    uint32_t unit;
+};
+
+// Bir mantıksal aralığın tek bir üyeye düşen parçası
+struct Piece {
+    int member;
+    off_t offset;          // Üye içindeki offset
+    size_t buffer_offset;  // Aktarım tamponundaki konum
+    size_t size;
+};
+
+static std::mutex volume_mutex;                 // Aşağıdaki üç değişkeni korur
+static std::vector<std::string> members(1, DISK_FILENAME);
+static uint32_t stripe_unit = DEFAULT_STRIPE_UNIT;
+static std::map<int, std::shared_ptr<Volume>> open_volumes;  // Yalnızca birden çok üyeli birimler
+
+//-------------------------
+// Hizalı tampon havuzu
+//-------------------------
+
+static char* get_buffer() {
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        if (!free_buffers.empty()) {
+            char* buffer = free_buffers.back();
+            free_buffers.pop_back();
+            return buffer;
+        }
+    }
+    void* buffer = NULL;
+    if (posix_memalign(&buffer, 4096, DIRECT_BUFFER_SIZE) != 0)
+        return NULL;
+    return (char*)buffer;
+}
+
+static void put_buffer(char* buffer) {
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    if (free_buffers.size() < DIRECT_POOL_MAX)
+        free_buffers.push_back(buffer);
+    else
+        free(buffer);
+}
+
+//-------------------------
+// Tamponlu yol
+//-------------------------
+
+// Kısa okumaları tekrarlayarak tam olarak size byte okur
+static bool pread_full(int fd, char* buffer, size_t size, off_t offset) {
+    while (size > 0) {
+        ssize_t bytes = pread(fd, buffer, size, offset);
+        if (bytes <= 0)
+            return false;
+        buffer += bytes;
+        size -= bytes;
+        offset += bytes;
+    }
+    return true;
+}
+
+// Kısa yazmaları tekrarlayarak tam olarak size byte yazar
+static bool pwrite_full(int fd, const char* buffer, size_t size, off_t offset) {
+    while (size > 0) {
+        ssize_t bytes = pwrite(fd, buffer, size, offset);
+        if (bytes <= 0)
+            return false;
+        buffer += bytes;
+        size -= bytes;
+        offset += bytes;
+    }
+    return true;
+}
+
+//-------------------------
+// Direct yol
+//-------------------------
+
+// Hizalı aralığı okur; dosya sonundan sonrası sıfırla doldurulur.
+static bool read_aligned(int fd, char* buffer, size_t size, off_t offset) {
+    while (size > 0) {
+        ssize_t bytes = pread(fd, buffer, size, offset);
+        if (bytes < 0)
+            return false;
+        if (bytes == 0) {
+            memset(buffer, 0, size);
+            return true;
+        }
+        buffer += bytes;
+        size -= bytes;
+        offset += bytes;
+    }
+    return true;
+}
+
+static bool is_direct_fd(int fd) {
+    int flags = fcntl(fd, F_GETFL);
+    return flags >= 0 && (flags & O_DIRECT);
+}
+
+static bool direct_pread(int fd, char* buffer, size_t size, off_t offset) {
+    char* bounce = get_buffer();
+    if (bounce == NULL)
+        return false;
+    bool ok = true;
+    while (ok && size > 0) {
+        off_t start = offset - offset % alignment;
+        size_t chunk = std::min(size, DIRECT_BUFFER_SIZE - (size_t)(offset - start));
+        size_t span = (offset - start) + chunk;
+        span = (span + alignment - 1) / alignment * alignment;
+        ok = read_aligned(fd, bounce, span, start);
+        if (ok)
+            memcpy(buffer, bounce + (offset - start), chunk);
+        buffer += chunk;
+        size -= chunk;
+        offset += chunk;
+    }
+    put_buffer(bounce);
+    return ok;
+}
+
+// Hizalanmamış baş/son blok, bloğu paylaşan diğer yazıcılarla çakışmasın diye kilitlenir,
+// okunur, değiştirilir ve hizalı aralığın tamamı tek seferde yazılır.
+static bool direct_pwrite(int fd, const char* buffer, size_t size, off_t offset) {
+    char* bounce = get_buffer();
+    if (bounce == NULL)
+        return false;
+    bool ok = true;
+    while (ok && size > 0) {
+        off_t start = offset - offset % alignment;
+        size_t chunk = std::min(size, DIRECT_BUFFER_SIZE - (size_t)(offset - start));
+        size_t head = offset - start;
+        size_t span = (head + chunk + alignment - 1) / alignment * alignment;
+        bool partial_head = head != 0;
+        bool partial_tail = (head + chunk) % alignment != 0;
+        off_t tail_block = start + span - alignment;
+        std::vector<int> locks;
+        if (partial_head)
+            locks.push_back((start / alignment) % BLOCK_LOCKS);
+        if (partial_tail)
+            locks.push_back((tail_block / alignment) % BLOCK_LOCKS);
+        std::sort(locks.begin(), locks.end());
+        locks.erase(std::unique(locks.begin(), locks.end()), locks.end());
+        for (size_t i = 0; i < locks.size(); i++)
+            block_locks[locks[i]].lock();
+        if (partial_head)
+            ok = read_aligned(fd, bounce, alignment, start);
+        if (ok && partial_tail && !(partial_head && tail_block == start))
+            ok = read_aligned(fd, bounce + span - alignment, alignment, tail_block);
+        if (ok) {
+            memcpy(bounce + head, buffer, chunk);
+            ok = pwrite_full(fd, bounce, span, start);
+        }
+        for (size_t i = locks.size(); i > 0; i--)
+            block_locks[locks[i - 1]].unlock();
+        buffer += chunk;
+        size -= chunk;
+        offset += chunk;
+    }
+    put_buffer(bounce);
+    return ok;
+}
+
+// Tek bir imaj dosyasına (veya birim üyesine) aktarım
+static bool file_io(int fd, char* buffer, size_t size, off_t offset, bool write) {
+    if (is_direct_fd(fd))
+        return write ? direct_pwrite(fd, buffer, size, offset) : direct_pread(fd, buffer, size, offset);
+    return write ? pwrite_full(fd, buffer, size, offset) : pread_full(fd, buffer, size, offset);
+}
+
+//-------------------------
+// Şeritleme (striping)
+//-------------------------
+
+static std::shared_ptr<Volume> find_volume(int fd) {
+    std::lock_guard<std::mutex> lock(volume_mutex);
+    auto it = open_volumes.find(fd);
+    return it == open_volumes.end() ? std::shared_ptr<Volume>() : it->second;
+}
+
+// Her üyede METADATA_SIZE'dan sonra tam olarak sığan şerit satırı sayısı
+static off_t stripe_rows(uint32_t unit) {
+    return (DISK_SIZE - METADATA_SIZE) / unit;
+}
+
+static off_t volume_capacity(size_t count, uint32_t unit) {
+    return METADATA_SIZE + (off_t)count * stripe_rows(unit) * unit;
+}
+
+// Mantıksal [offset, offset+size) aralığını üye parçalarına böler
+static void map_range(const Volume& vol, off_t offset, size_t size, std::vector<Piece>& pieces) {
+    off_t count = vol.fds.size();
+    size_t done = 0;
+    while (done < size) {
+        off_t logical = offset + done;
+        Piece piece;
+        piece.buffer_offset = done;
+        if (logical < METADATA_SIZE) {
+            piece.member = 0;
+            piece.offset = logical;
+            piece.size = std::min(size - done, (size_t)(METADATA_SIZE - logical));
+        } else {
+            off_t stripe = (logical - METADATA_SIZE) / vol.unit;
+            off_t within = (logical - METADATA_SIZE) % vol.unit;
+            piece.member = stripe % count;
+            piece.offset = METADATA_SIZE + (stripe / count) * vol.unit + within;
+            piece.size = std::min(size - done, (size_t)(vol.unit - within));
+        }
+        pieces.push_back(piece);
+        done += piece.size;
+    }
+}
+
+// Parçalar üyelere göre gruplanır. Aktarım birden çok üyeye yayılıyor ve en az bir şerit
+// boyundaysa her üyenin parçaları ayrı bir görevde çalışır; üyeler paralel okunur/yazılır.
+static bool volume_io(const Volume& vol, char* buffer, size_t size, off_t offset, bool write) {
+    std::vector<Piece> pieces;
+    map_range(vol, offset, size, pieces);
+    std::vector<std::vector<Piece>> by_member(vol.fds.size());
+    for (size_t i = 0; i < pieces.size(); i++)
+        by_member[pieces[i].member].push_back(pieces[i]);
+    std::atomic<bool> failed(false);
+    std::vector<std::function<void()>> tasks;
+    for (size_t m = 0; m < by_member.size(); m++) {
+        if (by_member[m].empty())
+            continue;
+        const std::vector<Piece>& list = by_member[m];
+        int fd = vol.fds[m];
+        tasks.push_back([&failed, &list, fd, buffer, write]() {
+            for (size_t i = 0; i < list.size() && !failed; i++) {
+                if (!file_io(fd, buffer + list[i].buffer_offset, list[i].size, list[i].offset, write))
+                    failed = true;
+            }
+        });
+    }
+    if (tasks.size() > 1 && size >= vol.unit) {
+        fs_parallel_run(tasks);
+    } else {
+        for (size_t i = 0; i < tasks.size(); i++)
+            tasks[i]();
+    }
+    return !failed;
+}
+
+// Dosyadaki veri içeren (delik olmayan) aralıkları SEEK_DATA/SEEK_HOLE ile bulur.
+// Dosya sistemi desteklemiyorsa tüm dosya tek bir veri aralığı sayılır.
+static void file_segments(int fd, off_t size, std::vector<std::pair<off_t, off_t>>& segments) {
+    off_t offset = 0;
+    while (offset < size) {
+        off_t data = lseek(fd, offset, SEEK_DATA);
+        if (data < 0) {
+            if (errno != ENXIO)      // ENXIO: sonrasında veri yok
+                segments.push_back(std::make_pair(offset, size));
+            break;
+        }
+        off_t hole = lseek(fd, data, SEEK_HOLE);
+        if (hole < 0 || hole > size)
+            hole = size;
+        segments.push_back(std::make_pair(data, hole));
+        offset = hole;
+    }
+}
+
+//-------------------------
+// Arayüz
+//-------------------------
+
+// Aynı dosyaya farklı yollarla verilen üyeleri ayırt etmek için kullanılan kimlik. İmaj
+// varsa (st_dev, st_ino); henüz yoksa (formatlanacaksa) bulunduğu dizinin kimliği ve adı.
+struct MemberIdentity {
+    dev_t dev;
+    ino_t ino;
+    std::string name;
+
+    bool operator==(const MemberIdentity& other) const {
+        return dev == other.dev && ino == other.ino && name == other.name;
+    }
+};
+
+static int member_identity(const std::string& path, MemberIdentity& id) {
+    struct stat st;
+    id.name.clear();
+    if (stat(path.c_str(), &st) < 0) {
+        if (errno != ENOENT)
+            return -1;
+        size_t slash = path.rfind('/');
+        std::string dir = slash == std::string::npos ? "." : path.substr(0, slash + 1);
+        id.name = slash == std::string::npos ? path : path.substr(slash + 1);
+        if (stat(dir.c_str(), &st) < 0)
+            return -1;
+    }
+    id.dev = st.st_dev;
+    id.ino = st.st_ino;
+    return 0;
+}
+
+int disk_set_volume(const std::vector<std::string>& images, uint32_t unit) {
+    if (images.empty() || images.size() > (size_t)MAX_VOLUME_MEMBERS) {
+        std::fprintf(stderr, "disk_set_volume: Imaj sayisi 1 ile %d arasinda olmali\n", MAX_VOLUME_MEMBERS);
+        return -1;
+    }
+    // Aynı imaj iki kez verilirse iki üyenin şeritleri aynı fiziksel alana düşer.
+    std::vector<MemberIdentity> ids(images.size());
+    for (size_t i = 0; i < images.size(); i++) {
+        if (member_identity(images[i], ids[i]) < 0) {
+            perror(("disk_set_volume: " + images[i]).c_str());
+            return -1;
+        }
+        for (size_t j = 0; j < i; j++) {
+            if (ids[j] == ids[i]) {
+                std::fprintf(stderr, "disk_set_volume: Ayni imaj birden fazla verildi: %s\n", images[i].c_str());
+                return -1;
+            }
+        }
+    }
+    // Direct modda üye offsetlerinin hizalı kalması için şerit boyu 4096'nın katı olmalı.
+    if (unit == 0 || unit % 4096 != 0 || unit > (uint32_t)(DISK_SIZE - METADATA_SIZE)) {
+        std::fprintf(stderr, "disk_set_volume: Gecersiz serit boyutu: %u\n", unit);
+        return -1;
+    }
+    std::lock_guard<std::mutex> lock(volume_mutex);
+    members = images;
+    stripe_unit = unit;
+    return 0;
+}
+
+void disk_get_volume(std::vector<std::string>& images, uint32_t& unit) {
+    std::lock_guard<std::mutex> lock(volume_mutex);
+    images = members;
+    unit = stripe_unit;
+}
+
+int disk_member_count() {
+    std::lock_guard<std::mutex> lock(volume_mutex);
+    return (int)members.size();
+}
+
+uint32_t disk_stripe_unit() {
+    std::lock_guard<std::mutex> lock(volume_mutex);
+    return stripe_unit;
+}
+
+uint32_t disk_capacity() {
+    std::lock_guard<std::mutex> lock(volume_mutex);
+    return (uint32_t)volume_capacity(members.size(), stripe_unit);
+}
+
+int disk_open(int flags, mode_t mode) {
+    if (direct_mode) {
+        flags |= O_DIRECT;
+        if ((flags & O_ACCMODE) == O_WRONLY)
+            flags = (flags & ~O_ACCMODE) | O_RDWR;
+    }
+    std::shared_ptr<Volume> vol(new Volume());
+    std::vector<std::string> images;
+    {
+        std::lock_guard<std::mutex> lock(volume_mutex);
+        images = members;
+        vol->unit = stripe_unit;
+    }
+    for (size_t i = 0; i < images.size(); i++) {
+        int fd = open(images[i].c_str(), flags, mode);
+        if (fd < 0) {
+            int saved = errno;
+            for (size_t j = 0; j < vol->fds.size(); j++)
+                close(vol->fds[j]);
+            errno = saved;
+            return -1;
+        }
+        vol->fds.push_back(fd);
+    }
+    if (vol->fds.size() > 1) {
+        std::lock_guard<std::mutex> lock(volume_mutex);
+        open_volumes[vol->fds[0]] = vol;
+    }
+    return vol->fds[0];
+}
+
+int disk_close(int fd) {
+    std::shared_ptr<Volume> vol;
+    {
+        std::lock_guard<std::mutex> lock(volume_mutex);
+        auto it = open_volumes.find(fd);
+        if (it != open_volumes.end()) {
+            vol = it->second;
+            open_volumes.erase(it);
+        }
+    }
+    if (vol) {
+        for (size_t i = 1; i < vol->fds.size(); i++)
+            close(vol->fds[i]);
+    }
+    return close(fd);
+}
+
+bool disk_pread(int fd, char* buffer, size_t size, off_t offset) {
+    std::shared_ptr<Volume> vol = find_volume(fd);
+    if (vol)
+        return volume_io(*vol, buffer, size, offset, false);
+    return file_io(fd, buffer, size, offset, false);
+}
+
+bool disk_pwrite(int fd, const char* buffer, size_t size, off_t offset) {
+    std::shared_ptr<Volume> vol = find_volume(fd);
+    if (vol)
+        return volume_io(*vol, const_cast<char*>(buffer), size, offset, true);
+    return file_io(fd, const_cast<char*>(buffer), size, offset, true);
+}
+
+off_t disk_size(int fd) {
+    std::shared_ptr<Volume> vol = find_volume(fd);
+    if (vol)
+        return volume_capacity(vol->fds.size(), vol->unit);
+    struct stat st;
+    if (fstat(fd, &st) < 0)
+        return -1;
+    return st.st_size;
+}
+
+// Birimde her üye, mantıksal [0, size) aralığından kendisine düşen son parçanın sonuna kadar
+// boyutlandırılır.
+int disk_truncate(int fd, off_t size) {
+    std::shared_ptr<Volume> vol = find_volume(fd);
+    if (!vol)
+        return ftruncate(fd, size);
+    off_t count = vol->fds.size();
+    off_t data = std::max((off_t)0, size - METADATA_SIZE);
+    off_t rows = data / (count * vol->unit);
+    off_t rest = data % (count * vol->unit);
+    for (off_t i = 0; i < count; i++) {
+        off_t member_size;
+        if (size <= METADATA_SIZE)
+            member_size = (i == 0) ? size : 0;
+        else
+            member_size = METADATA_SIZE + rows * vol->unit +
+                          std::min((off_t)vol->unit, std::max((off_t)0, rest - i * vol->unit));
+        if (ftruncate(vol->fds[i], member_size) < 0)
+            return -1;
+    }
+    return 0;
+}
+
+// Ardışık bir mantıksal aralığın her üyeye düşen parçaları üye içinde de ardışıktır;
+// bu yüzden her üyede tek bir delik açılır.
+int disk_punch(int fd, off_t start, off_t size) {
+    std::shared_ptr<Volume> vol = find_volume(fd);
+    if (!vol)
+        return fallocate(fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, start, size);
+    std::vector<Piece> pieces;
+    map_range(*vol, start, size, pieces);
+    std::vector<off_t> begin(vol->fds.size(), -1), end(vol->fds.size(), -1);
+    for (size_t i = 0; i < pieces.size(); i++) {
+        int m = pieces[i].member;
+        if (begin[m] < 0)
+            begin[m] = pieces[i].offset;
+        end[m] = pieces[i].offset + pieces[i].size;
+    }
+    for (size_t m = 0; m < vol->fds.size(); m++) {
+        if (begin[m] >= 0 &&
+            fallocate(vol->fds[m], FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, begin[m], end[m] - begin[m]) < 0)
+            return -1;
+    }
+    return 0;
+}
+
+// Birimde her üyenin veri aralıkları mantıksal aralıklara çevrilir, sıralanır ve birleştirilir.
+void disk_data_segments(int fd, off_t size, std::vector<std::pair<off_t, off_t>>& segments) {
+    segments.clear();
+    std::shared_ptr<Volume> vol = find_volume(fd);
+    if (!vol) {
+        file_segments(fd, size, segments);
+        return;
+    }
+    off_t count = vol->fds.size();
+    std::vector<std::pair<off_t, off_t>> logical;
+    for (off_t m = 0; m < count; m++) {
+        struct stat st;
+        if (fstat(vol->fds[m], &st) < 0)
+            continue;
+        std::vector<std::pair<off_t, off_t>> physical;
+        file_segments(vol->fds[m], st.st_size, physical);
+        for (size_t i = 0; i < physical.size(); i++) {
+            off_t p = physical[i].first;
+            while (p < physical[i].second) {
+                off_t length;
+                if (p < METADATA_SIZE) {
+                    // Metadata alanı yalnızca ilk üyede anlamlıdır; diğerlerinde etiket bulunur.
+                    length = std::min(physical[i].second, (off_t)METADATA_SIZE) - p;
+                    if (m == 0)
+                        logical.push_back(std::make_pair(p, p + length));
+                } else {
+                    off_t row = (p - METADATA_SIZE) / vol->unit;
+                    off_t within = (p - METADATA_SIZE) % vol->unit;
+                    length = std::min(physical[i].second - p, (off_t)vol->unit - within);
+                    off_t start = METADATA_SIZE + (row * count + m) * vol->unit + within;
+                    logical.push_back(std::make_pair(start, start + length));
+                }
+                p += length;
+            }
+        }
+    }
+    std::sort(logical.begin(), logical.end());
+    for (size_t i = 0; i < logical.size(); i++) {
+        if (logical[i].first >= size)
+            break;
+        logical[i].second = std::min(logical[i].second, size);
+        if (!segments.empty() && logical[i].first <= segments.back().second)
+            segments.back().second = std::max(segments.back().second, logical[i].second);
+        else
+            segments.push_back(logical[i]);
+    }
+}
+
+int disk_write_labels(int fd, uint32_t volume_id) {
+    std::shared_ptr<Volume> vol = find_volume(fd);
+    if (!vol)
+        return 0;
+    for (size_t i = 1; i < vol->fds.size(); i++) {
+        MemberLabel label;
+        memset(&label, 0, sizeof(label));
+        label.magic = MEMBER_MAGIC;
+        label.volume_id = volume_id;
+        label.index = (uint16_t)i;
+        label.count = (uint16_t)vol->fds.size();
+        label.stripe_unit = vol->unit;
+        if (!file_io(vol->fds[i], (char*)&label, sizeof(label), 0, true))
+            return -1;
+    }
+    return 0;
+}
+
+int disk_check_labels(int fd, uint32_t volume_id) {
+    std::shared_ptr<Volume> vol = find_volume(fd);
+    if (!vol)
+        return 0;
+    for (size_t i = 1; i < vol->fds.size(); i++) {
+        MemberLabel label;
+        if (!file_io(vol->fds[i], (char*)&label, sizeof(label), 0, false) ||
+            label.magic != MEMBER_MAGIC || label.volume_id != volume_id || label.index != i ||
+            label.count != vol->fds.size() || label.stripe_unit != vol->unit) {
+            std::fprintf(stderr, "disk_check_labels: %zu. imaj bu birime ait degil veya sirasi yanlis\n", i + 1);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Tek bir imajın O_DIRECT ile kabul ettiği hizalamayı dener: önce BLOCK_SIZE, olmazsa
+// 4096 byte. Bulunamazsa 0 döner.
+static size_t probe_alignment(const std::string& image, char* probe) {
+    int fd = open(image.c_str(), O_RDWR | O_DIRECT);
+    if (fd < 0) {
+        perror(("disk_set_direct: " + image + " O_DIRECT ile acilamadi").c_str());
+        return 0;
+    }
+    size_t candidates[] = { (size_t)BLOCK_SIZE, 4096 };
+    size_t found = 0;
+    for (size_t i = 0; i < sizeof(candidates) / sizeof(candidates[0]) && found == 0; i++) {
+        if (pread(fd, probe, candidates[i], candidates[i]) >= 0)
+            found = candidates[i];
+    }
+    // Tamponlu moddan kalan kirli sayfalar diske yazılır.
+    fdatasync(fd);
+    close(fd);
+    return found;
+}
+
+// Direct modu açarken her üyenin kabul ettiği hizalama denenir; birim için en büyüğü kullanılır.
+int disk_set_direct(bool enabled) {
+    if (!enabled) {
+        direct_mode = false;
+        return 0;
+    }
+    std::vector<std::string> images;
+    {
+        std::lock_guard<std::mutex> lock(volume_mutex);
+        images = members;
+    }
+    char* probe = get_buffer();
+    if (probe == NULL)
+        return -1;
+    size_t found = 0;
+    for (size_t i = 0; i < images.size(); i++) {
+        size_t member_alignment = probe_alignment(images[i], probe);
+        if (member_alignment == 0) {
+            found = 0;
+            break;
+        }
+        found = std::max(found, member_alignment);
+    }
+    put_buffer(probe);
+    if (found == 0) {
+        std::fprintf(stderr, "disk_set_direct: Desteklenen hizalama bulunamadi\n");
+        return -1;
+    }
+    alignment = found;
+    direct_mode = true;
+    return 0;
+}
+
+bool disk_direct() {
+    return direct_mode;
+}
+
+size_t disk_alignment() {
+    return alignment;
+}
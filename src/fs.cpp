@@ -1,4 +1,7 @@
 #include "fs.h"
+#include "fs_async.h"
+#include "fs_internal.h"
+#include "disk.h"
 #include <iostream>
 #include <cstdio>
 #include <fcntl.h>
@@ -8,158 +11,1255 @@
 #include <cerrno>
 #include <vector>
 #include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+#include <new>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
-const char* DISK_FILENAME = "disk.sim";
 const char* LOG_FILENAME  = "fs.log";
 
+// fs_mutex: metadata okuma-değiştirme-yazma döngülerini süreç içinde serileştirir.
+// extent_mutex: veri alanını okuyanlar paylaşımlı, veri alanına yazan/taşıyan işlemler
+// (yazma, defragment, geri yükleme, formatlama) özel kilit alır. Böylece fs_read'ler
+// metadata kilidini bırakıp birbirleriyle paralel okuyabilir.
+static std::recursive_mutex fs_mutex;
+static std::shared_mutex extent_mutex;
+
 //-------------------------
-// Yardımcı Fonksiyonlar
+// Paylaşımlı metadata
 //-------------------------
 
-// Disk üzerindeki metadata bilgisini yükler (ilk int file_count ardından MAX_FILES adet metadata)
-static int load_metadata(FileMetadata files[], int *file_count) {
-    int fd = open(DISK_FILENAME, O_RDWR);
+// Paylaşımlı modda ilk imajın metadata alanı (süper blok, dizin hash'i dahil metadata
+// tablosu ve snapshot tabloları) MAP_SHARED ile eşlenir; aynı imajı kullanan süreçler
+// aynı sayfaları görür. Yanındaki "<imaj>.lock" dosyası iki iş görür:
+//  - başındaki SharedHeader::seq bir seqlock sayacıdır. Yazıcı değişiklikten önce sayacı
+//    tek sayıya, sonra çift sayıya çıkarır; okuyucular kilit almadan kopyalar ve sayaç
+//    değişmişse (veya tekse) yeniden dener.
+//  - fcntl kayıt kilidiyle süreçler arası yazıcı kilidi olarak kullanılır. Kayıt kilitleri
+//    sürece aittir; fork ile oluşan çocuk süreç ebeveyninin kilidini paylaşmaz.
+// Sayaç imajın dışında tutulur; format ve geri yükleme onu sıfırlayamaz.
+struct SharedHeader {
+    uint32_t seq;
+};
+
+const int SHARED_READ_ATTEMPTS = 4;       // fs_read, yazıcıları durdurmadan önce bu kadar dener
+const int SHARED_SPIN_LIMIT = 1000;       // Tek sayaçta bu kadar beklendikçe yazıcı yoklanır
+
+static char* shared_metadata = NULL;       // NULL: paylaşımlı mod kapalı
+static SharedHeader* shared_header = NULL;
+static int shared_lock_fd = -1;
+static thread_local int shared_write_depth = 0;  // Bu iş parçacığındaki iç içe yazma bölümleri
+static int writer_depth = 0;               // İç içe yazıcı kilitleri (fs_mutex altında)
+static bool writer_locked = false;         // Kilit dosyası üzerinde kayıt kilidi tutuluyor
+
+// Kilit dosyasının tamamı üzerinde yazma kilidi alır veya bırakır. wait false ise
+// kilit başka bir süreçteyse beklemeden -1 döner.
+static int lock_file(short type, bool wait = true) {
+    struct flock fl;
+    memset(&fl, 0, sizeof(fl));
+    fl.l_type = type;
+    fl.l_whence = SEEK_SET;
+    while (fcntl(shared_lock_fd, wait ? F_SETLKW : F_SETLK, &fl) < 0) {
+        if (errno != EINTR)
+            return -1;
+    }
+    return 0;
+}
+
+// Sayaç uzun süre tek kaldığında çağrılır. Yazıcı kilidini tutan bir süreç yoksa yazıcı
+// yazma bölümündeyken ölmüştür (kayıt kilitleri süreçle birlikte bırakılır); sayaç, yeni
+// bir yazıcıyla yarışmamak için kilit alınarak çift yapılır. Metadata yarım kalmış olabilir,
+// writer_lock'taki onarımla aynı şekilde olduğu gibi kabul edilir.
+static void shared_repair(uint32_t seq) {
+    if (writer_locked || lock_file(F_WRLCK, false) < 0)
+        return;
+    __atomic_compare_exchange_n(&shared_header->seq, &seq, seq + 1, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+    lock_file(F_UNLCK);
+}
+
+template <typename Copy>
+static void shared_read(Copy copy) {
+    // Yazma bölümündeki iş parçacığı kendi değişikliklerini beklemeden okur.
+    if (shared_write_depth > 0) {
+        copy();
+        return;
+    }
+    int spins = 0;
+    while (true) {
+        uint32_t before = __atomic_load_n(&shared_header->seq, __ATOMIC_ACQUIRE);
+        if (before & 1) {
+            if (++spins % SHARED_SPIN_LIMIT == 0)
+                shared_repair(before);
+            std::this_thread::yield();
+            continue;
+        }
+        copy();
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&shared_header->seq, __ATOMIC_RELAXED) == before)
+            return;
+    }
+}
+
+// Yazıcı kilidi tutulurken çağrılır.
+static void shared_write_begin() {
+    if (shared_write_depth++ > 0)
+        return;
+    __atomic_store_n(&shared_header->seq, shared_header->seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static void shared_write_end() {
+    if (--shared_write_depth > 0)
+        return;
+    __atomic_store_n(&shared_header->seq, shared_header->seq + 1, __ATOMIC_RELEASE);
+}
+
+// Birden çok adımda yapılan değişiklikleri (format, geri yükleme) okuyuculara tek bir
+// değişiklik olarak gösterir.
+class SharedWriteSection {
+public:
+    SharedWriteSection() : active(shared_metadata != NULL) {
+        if (active)
+            shared_write_begin();
+    }
+    ~SharedWriteSection() {
+        if (active)
+            shared_write_end();
+    }
+private:
+    bool active;
+};
+
+static void name_index_commit(const SuperBlock* sb);
+static void name_index_end_operation();
+
+// fs_mutex tutulurken çağrılır; paylaşımlı modda en dıştaki çağrı kayıt kilidini alır.
+// Kilit alınamazsa false döner; çağıran metadata'yı değiştirmeden -1 ile çıkmalıdır.
+// İç içe çağrılar dıştaki kilide güvenir.
+static bool writer_lock() {
+    if (writer_depth++ > 0 || shared_metadata == NULL)
+        return true;
+    if (lock_file(F_WRLCK) < 0) {
+        perror("writer_lock: kilit alinamadi");
+        return false;
+    }
+    writer_locked = true;
+    // Yazma sırasında ölen bir süreç sayacı tek bırakır; okuyucular sonsuza dek beklemesin.
+    if (shared_header->seq & 1)
+        __atomic_store_n(&shared_header->seq, shared_header->seq + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+static void writer_unlock() {
+    if (--writer_depth > 0)
+        return;
+    name_index_end_operation();
+    if (!writer_locked)
+        return;
+    lock_file(F_UNLCK);
+    writer_locked = false;
+}
+
+// Metadata'yı değiştiren tüm genel fonksiyonlar bu kilidi alır: süreç içinde fs_mutex,
+// paylaşımlı modda ayrıca diğer süreçlere karşı yazıcı kilidi. locked() false ise
+// fonksiyon hiçbir şeyi değiştirmeden -1 döner.
+class FsWriteLock {
+public:
+    FsWriteLock() : guard(fs_mutex), held(writer_lock()) {}
+    ~FsWriteLock() { writer_unlock(); }
+    bool locked() const { return held; }
+private:
+    std::lock_guard<std::recursive_mutex> guard;
+    bool held;
+};
+
+static void unmap_shared() {
+    if (shared_metadata == NULL)
+        return;
+    munmap(shared_metadata, METADATA_SIZE);
+    munmap(shared_header, sizeof(SharedHeader));
+    close(shared_lock_fd);  // Tutulan kayıt kilidi de bırakılır.
+    shared_metadata = NULL;
+    shared_header = NULL;
+    shared_lock_fd = -1;
+    writer_locked = false;
+}
+
+// Birimin ilk imajının metadata alanını ve kilit dosyasını eşler.
+static int map_shared() {
+    std::vector<std::string> images;
+    uint32_t unit;
+    disk_get_volume(images, unit);
+    std::string lock_path = images[0] + ".lock";
+    int fd = open(images[0].c_str(), O_RDWR);
     if (fd < 0) {
-        perror("load_metadata: disk.sim acilamadi");
+        perror("map_shared: disk.sim acilamadi");
         return -1;
     }
-    if (read(fd, file_count, sizeof(int)) != sizeof(int)) {
-        perror("load_metadata: file_count okunurken hata");
+    struct stat st;
+    if (fstat(fd, &st) < 0 || st.st_size < METADATA_SIZE) {
+        std::cerr << "map_shared: Imaj formatlanmamis\n";
         close(fd);
         return -1;
     }
-    if (read(fd, files, sizeof(FileMetadata) * MAX_FILES) != sizeof(FileMetadata) * MAX_FILES) {
-        perror("load_metadata: metadata okunurken hata");
-        close(fd);
+    void* metadata = mmap(NULL, METADATA_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (metadata == MAP_FAILED) {
+        perror("map_shared: metadata eslenemedi");
         return -1;
     }
-    close(fd);
+    int lock_fd = open(lock_path.c_str(), O_RDWR | O_CREAT, 0666);
+    if (lock_fd < 0 || fstat(lock_fd, &st) < 0 ||
+        (st.st_size < (off_t)sizeof(SharedHeader) && ftruncate(lock_fd, sizeof(SharedHeader)) < 0)) {
+        perror("map_shared: kilit dosyasi hazirlanamadi");
+        if (lock_fd >= 0)
+            close(lock_fd);
+        munmap(metadata, METADATA_SIZE);
+        return -1;
+    }
+    void* header = mmap(NULL, sizeof(SharedHeader), PROT_READ | PROT_WRITE, MAP_SHARED, lock_fd, 0);
+    if (header == MAP_FAILED) {
+        perror("map_shared: kilit dosyasi eslenemedi");
+        close(lock_fd);
+        munmap(metadata, METADATA_SIZE);
+        return -1;
+    }
+    shared_metadata = (char*)metadata;
+    shared_header = (SharedHeader*)header;
+    shared_lock_fd = lock_fd;
+    // Eşleme bir yazıcı kilidinin içinde açıldıysa kilit burada alınır.
+    if (writer_depth > 0) {
+        if (lock_file(F_WRLCK) < 0) {
+            perror("map_shared: kilit alinamadi");
+            unmap_shared();
+            return -1;
+        }
+        writer_locked = true;
+    }
     return 0;
 }
 
-// Değiştirilmiş metadata bilgisini diske yazar
-static int write_metadata(FileMetadata files[], int file_count) {
-    int fd = open(DISK_FILENAME, O_RDWR);
+//-------------------------
+// Yardımcı Fonksiyonlar
+//-------------------------
+
+// Disk üzerindeki metadata bilgisini yükler (önce SuperBlock ardından MAX_FILES adet metadata)
+static int load_metadata(SuperBlock* sb, FileMetadata files[]) {
+    if (shared_metadata != NULL) {
+        // Süper blok ve tablo tutarlı tek bir kopya olarak eşlenmiş alandan alınır.
+        shared_read([&] {
+            memcpy(sb, shared_metadata, sizeof(SuperBlock));
+            memcpy(files, shared_metadata + sizeof(SuperBlock), sizeof(FileMetadata) * MAX_FILES);
+        });
+        if (sb->magic != FS_MAGIC || sb->version != FS_VERSION) {
+            std::cerr << "load_metadata: Disk formatlanmamis veya surum uyumsuz\n";
+            return -1;
+        }
+        return 0;
+    }
+    int fd = disk_open(O_RDONLY);
     if (fd < 0) {
-        perror("write_metadata: disk.sim acilamadi");
+        perror("load_metadata: disk.sim acilamadi");
         return -1;
     }
-    if (lseek(fd, 0, SEEK_SET) < 0) {
-        perror("write_metadata: lseek hatasi");
-        close(fd);
+    if (!disk_pread(fd, (char*)sb, sizeof(SuperBlock), 0)) {
+        perror("load_metadata: superblock okunurken hata");
+        disk_close(fd);
         return -1;
     }
-    if (write(fd, &file_count, sizeof(int)) != sizeof(int)) {
-        perror("write_metadata: file_count yazilirken hata");
-        close(fd);
+    if (sb->magic != FS_MAGIC || sb->version != FS_VERSION) {
+        std::cerr << "load_metadata: Disk formatlanmamis veya surum uyumsuz\n";
+        disk_close(fd);
+        return -1;
+    }
+    if (!disk_pread(fd, (char*)files, sizeof(FileMetadata) * MAX_FILES, sizeof(SuperBlock))) {
+        perror("load_metadata: metadata okunurken hata");
+        disk_close(fd);
+        return -1;
+    }
+    disk_close(fd);
+    return 0;
+}
+
+// Değiştirilmiş metadata bilgisini diske yazar
+static int write_metadata(const SuperBlock* sb, const FileMetadata files[]) {
+    if (shared_metadata != NULL) {
+        shared_write_begin();
+        memcpy(shared_metadata, sb, sizeof(SuperBlock));
+        memcpy(shared_metadata + sizeof(SuperBlock), files, sizeof(FileMetadata) * MAX_FILES);
+        shared_write_end();
+        name_index_commit(sb);
+        return 0;
+    }
+    // Süper blok ve tablo tek bir ardışık yazmayla diske gider.
+    std::vector<char> buffer(sizeof(SuperBlock) + sizeof(FileMetadata) * MAX_FILES);
+    memcpy(buffer.data(), sb, sizeof(SuperBlock));
+    memcpy(buffer.data() + sizeof(SuperBlock), files, sizeof(FileMetadata) * MAX_FILES);
+    int fd = disk_open(O_RDWR);
+    if (fd < 0) {
+        perror("write_metadata: disk.sim acilamadi");
         return -1;
     }
-    if (write(fd, files, sizeof(FileMetadata) * MAX_FILES) != sizeof(FileMetadata) * MAX_FILES) {
+    if (!disk_pwrite(fd, buffer.data(), buffer.size(), 0)) {
         perror("write_metadata: metadata yazilirken hata");
-        close(fd);
+        disk_close(fd);
         return -1;
     }
-    close(fd);
+    disk_close(fd);
+    name_index_commit(sb);
     return 0;
 }
 
 // Yeni dosya için veri bloğunun başlangıç offsetini hesaplar
-static uint32_t get_new_file_start(FileMetadata files[], int file_count, int new_size) {
-    uint32_t start = METADATA_SIZE; // Veri alanı metadata sonrasında başlar.
+static uint32_t get_new_file_start(const SuperBlock* sb, FileMetadata files[], int new_size) {
+    // Veri alanı metadata sonrasında başlar; snapshot'ların tuttuğu veri de atlanır.
+    uint32_t start = std::max((uint32_t)METADATA_SIZE, sb->snapshot_end);
     for (int i = 0; i < MAX_FILES; i++) {
-       if (files[i].valid) {
+       if (files[i].valid && files[i].type == FS_TYPE_FILE) {
            uint32_t end = files[i].start + files[i].size;
            if (end > start)
                 start = end;
        }
     }
-    if (start + new_size > DISK_SIZE)
+    if (start + new_size > disk_capacity())
          return 0;
     return start;
 }
 
-// Belirtilen isimde dosyanın indeksini döner (bulamazsa -1)
-static int find_file_index(const char* filename, FileMetadata files[], int file_count) {
+// Artık kullanılmayan veri aralığını FALLOC_FL_PUNCH_HOLE ile host dosya sistemine iade eder;
+// disk.sim seyrek kalır. Çağıran extent_mutex'i özel olarak tutmalıdır. Delik açma yalnızca
+// bir optimizasyon olduğu için desteklenmeyen dosya sistemlerinde sessizce atlanır.
+static void release_extent(uint32_t start, uint32_t size) {
+    if (size == 0)
+        return;
+    int fd = disk_open(O_RDWR);
+    if (fd < 0)
+        return;
+    if (disk_punch(fd, start, size) < 0 &&
+        errno != EOPNOTSUPP && errno != ENOSYS)
+        perror("release_extent: delik acilamadi");
+    disk_close(fd);
+}
+
+//-------------------------
+// Dizinler ve yol çözümleme
+//-------------------------
+
+// (parent, isim) çifti için dizin hash kovası (FNV-1a)
+static int dir_hash_bucket(int16_t parent, const char* name) {
+    uint32_t h = 2166136261u;
+    h = (h ^ (uint16_t)parent) * 16777619u;
+    for (const char* p = name; *p; p++)
+        h = (h ^ (uint8_t)*p) * 16777619u;
+    return h % DIR_HASH_SIZE;
+}
+
+// Girdiyi dizin hash tablosuna ekler
+static void dir_hash_insert(SuperBlock* sb, FileMetadata files[], int index) {
+    int bucket = dir_hash_bucket(files[index].parent, files[index].name);
+    files[index].hash_next = sb->dir_hash[bucket];
+    sb->dir_hash[bucket] = index;
+}
+
+// Girdiyi dizin hash tablosundan çıkarır
+static void dir_hash_remove(SuperBlock* sb, FileMetadata files[], int index) {
+    // Yapılar paketli olduğundan alanlara işaretçi alınmaz; zincir indekslerle yürünür.
+    int bucket = dir_hash_bucket(files[index].parent, files[index].name);
+    if (sb->dir_hash[bucket] == index) {
+        sb->dir_hash[bucket] = files[index].hash_next;
+    } else {
+        for (int i = sb->dir_hash[bucket]; i != -1; i = files[i].hash_next) {
+            if (files[i].hash_next == index) {
+                files[i].hash_next = files[index].hash_next;
+                break;
+            }
+        }
+    }
+    files[index].hash_next = -1;
+}
+
+// Bir dizin altındaki isim için girdi indeksini döner (bulamazsa -1)
+static int dir_lookup(const int16_t dir_hash[], const FileMetadata files[], int16_t parent, const char* name) {
+    for (int i = dir_hash[dir_hash_bucket(parent, name)]; i != -1; i = files[i].hash_next) {
+        if (files[i].valid && files[i].parent == parent && strcmp(files[i].name, name) == 0)
+            return i;
+    }
+    return -1;
+}
+
+// Yolu bileşenlerine ayırır; baştaki ve tekrarlanan '/' karakterleri yok sayılır.
+static bool split_path(const char* path, std::vector<std::string>& parts) {
+    parts.clear();
+    std::string current;
+    for (const char* p = path; ; p++) {
+        if (*p == '/' || *p == '\0') {
+            if (!current.empty()) {
+                if (current.size() >= (size_t)MAX_NAME || current == "." || current == "..")
+                    return false;
+                parts.push_back(current);
+                current.clear();
+            }
+            if (*p == '\0')
+                break;
+        } else {
+            current += *p;
+        }
+    }
+    return true;
+}
+
+// Dentry cache: normalize edilmiş yol -> girdi indeksi (-1: negatif girdi).
+// İsim alanı değiştiğinde SuperBlock::generation artar ve cache boşaltılır.
+static const size_t DENTRY_CACHE_MAX = 1024;
+static std::unordered_map<std::string, int> dentry_cache;
+static uint32_t dentry_generation = 0;
+static bool dentry_valid = false;
+
+static void dentry_sync(const SuperBlock* sb) {
+    if (!dentry_valid || dentry_generation != sb->generation || dentry_cache.size() >= DENTRY_CACHE_MAX) {
+        dentry_cache.clear();
+        dentry_generation = sb->generation;
+        dentry_valid = true;
+    }
+}
+
+static void dentry_invalidate() {
+    dentry_cache.clear();
+    dentry_valid = false;
+}
+
+// Sıralı isim indeksi: tam yola göre sıralı (yol, girdi indeksi) çiftleri.
+// fs_ls ve fs_list önek/aralık taramalarını lower_bound ile O(log n + k) sürede yapar.
+// Bu süreçteki değişiklikler indekse artımlı uygulanır; generation başka bir
+// süreç tarafından değiştirilmişse indeks baştan kurulur. Artımlı değişiklikler,
+// aynı generation'daki metadata diske yazılana kadar onaylanmamış sayılır; yazmadan
+// biten (başarısız) bir işlem indeksi geçersiz bırakır.
+typedef std::pair<std::string, int> NameIndexEntry;
+static std::vector<NameIndexEntry> name_index;
+static uint32_t name_index_generation = 0;
+static bool name_index_valid = false;
+static bool name_index_uncommitted = false;
+
+static std::string entry_path(const FileMetadata files[], int index);
+
+static bool name_index_current(const SuperBlock* sb) {
+    return name_index_valid && name_index_generation == sb->generation;
+}
+
+static void name_index_sync(const SuperBlock* sb, const FileMetadata files[]) {
+    if (name_index_current(sb))
+        return;
+    name_index.clear();
+    for (int i = 0; i < MAX_FILES; i++) {
+        if (files[i].valid)
+            name_index.push_back(NameIndexEntry(entry_path(files, i), i));
+    }
+    std::sort(name_index.begin(), name_index.end());
+    name_index_generation = sb->generation;
+    name_index_valid = true;
+}
+
+// Tek bir girdinin yolunu indekste günceller (old_path boşsa ekleme, new_path boşsa silme)
+static void name_index_apply(const SuperBlock* sb, const std::string& old_path, const std::string& new_path, int index) {
+    if (!name_index_current(sb))
+        return;
+    name_index_uncommitted = true;
+    if (!old_path.empty()) {
+        auto it = std::lower_bound(name_index.begin(), name_index.end(), NameIndexEntry(old_path, index));
+        if (it != name_index.end() && it->first == old_path)
+            name_index.erase(it);
+    }
+    if (!new_path.empty()) {
+        NameIndexEntry entry(new_path, index);
+        name_index.insert(std::lower_bound(name_index.begin(), name_index.end(), entry), entry);
+    }
+}
+
+// İsim alanını değiştiren işlemlerden sonra çağrılır
+static void bump_generation(SuperBlock* sb) {
+    bool keep_index = name_index_current(sb);
+    sb->generation++;
+    dentry_invalidate();
+    if (keep_index) {
+        name_index_generation = sb->generation;
+        name_index_uncommitted = true;
+    }
+}
+
+// write_metadata başarılı olduğunda çağrılır: yazılan süper blok indeksin generation'ını
+// taşıyorsa bekleyen değişiklikler artık diskte de vardır.
+static void name_index_commit(const SuperBlock* sb) {
+    if (name_index_uncommitted && name_index_generation == sb->generation)
+        name_index_uncommitted = false;
+}
+
+// En dıştaki yazıcı kilidi bırakılırken çağrılır.
+static void name_index_end_operation() {
+    if (name_index_uncommitted) {
+        name_index_valid = false;
+        name_index_uncommitted = false;
+    }
+}
+
+// Yol bileşenlerini verilen dizin hash tablosu üzerinde çözümler (cache kullanmaz)
+static int walk_path(const std::vector<std::string>& parts, const int16_t dir_hash[], const FileMetadata files[]) {
+    int16_t current = FS_ROOT;
+    int index = -1;
+    for (size_t i = 0; i < parts.size(); i++) {
+        if (current != FS_ROOT && files[current].type != FS_TYPE_DIR)
+            return -1;
+        index = dir_lookup(dir_hash, files, current, parts[i].c_str());
+        if (index == -1)
+            return -1;
+        current = index;
+    }
+    return index;
+}
+
+// Yolu çözümler ve girdi indeksini döner (kök için FS_ROOT, bulamazsa -1)
+static int lookup_path(const char* path, const SuperBlock* sb, const FileMetadata files[]) {
+    std::vector<std::string> parts;
+    if (!split_path(path, parts))
+        return -1;
+    if (parts.empty())
+        return FS_ROOT;
+    std::string key;
+    for (size_t i = 0; i < parts.size(); i++)
+        key += (i ? "/" : "") + parts[i];
+    dentry_sync(sb);
+    auto it = dentry_cache.find(key);
+    if (it != dentry_cache.end())
+        return it->second;
+    int index = walk_path(parts, sb->dir_hash, files);
+    dentry_cache[key] = index;
+    return index;
+}
+
+// Belirtilen yoldaki normal dosyanın indeksini döner (bulamazsa veya dizinse -1)
+static int find_file_index(const char* filename, const SuperBlock* sb, const FileMetadata files[]) {
+    int index = lookup_path(filename, sb, files);
+    if (index < 0 || files[index].type != FS_TYPE_FILE)
+        return -1;
+    return index;
+}
+
+// Yolun üst dizinini çözümler ve son bileşeni leaf'e yazar (bulamazsa -1)
+static int resolve_parent(const char* path, const SuperBlock* sb, const FileMetadata files[], std::string& leaf) {
+    std::vector<std::string> parts;
+    if (!split_path(path, parts) || parts.empty())
+        return -1;
+    leaf = parts.back();
+    std::string parent_path;
+    for (size_t i = 0; i + 1 < parts.size(); i++)
+        parent_path += parts[i] + "/";
+    int parent = lookup_path(parent_path.c_str(), sb, files);
+    if (parent == -1 || (parent != FS_ROOT && files[parent].type != FS_TYPE_DIR))
+        return -1;
+    return parent;
+}
+
+// Girdinin kökten itibaren tam yolunu oluşturur
+static std::string entry_path(const FileMetadata files[], int index) {
+    std::string path;
+    for (int i = index; i != FS_ROOT; i = files[i].parent)
+        path = "/" + std::string(files[i].name) + path;
+    return path;
+}
+
+// Boş bir metadata slotu döner (yoksa -1)
+static int find_free_slot(const FileMetadata files[]) {
     for (int i = 0; i < MAX_FILES; i++) {
-        if (files[i].valid && strcmp(files[i].name, filename) == 0)
+        if (!files[i].valid)
             return i;
     }
     return -1;
 }
 
+// Yeni bir girdiyi üst dizine bağlar
+static void link_entry(SuperBlock* sb, FileMetadata files[], int index, int16_t parent,
+                       const std::string& name, uint8_t type) {
+    memset(&files[index], 0, sizeof(FileMetadata));
+    files[index].valid = 1;
+    files[index].type = type;
+    files[index].parent = parent;
+    strncpy(files[index].name, name.c_str(), sizeof(files[index].name) - 1);
+    files[index].name[sizeof(files[index].name) - 1] = '\0';
+    files[index].creationTime = time(NULL);
+    dir_hash_insert(sb, files, index);
+    sb->file_count++;
+    name_index_apply(sb, "", entry_path(files, index), index);
+    bump_generation(sb);
+}
+
+// Girdiyi isim alanından çıkarır
+static void unlink_entry(SuperBlock* sb, FileMetadata files[], int index) {
+    name_index_apply(sb, entry_path(files, index), "", index);
+    dir_hash_remove(sb, files, index);
+    files[index].valid = 0;
+    sb->file_count--;
+    bump_generation(sb);
+}
+
+// Dizinin boş olup olmadığını kontrol eder
+static bool dir_is_empty(const FileMetadata files[], int16_t dir) {
+    for (int i = 0; i < MAX_FILES; i++) {
+        if (files[i].valid && files[i].parent == dir)
+            return false;
+    }
+    return true;
+}
+
+// Girdiyi yeni üst dizine ve isme taşır; veri bloklarına dokunmaz.
+// allow_cross_dir false ise yalnızca aynı dizin içinde yeniden adlandırma yapılır.
+static int move_entry(const char* op, const char* old_path, const char* new_path, bool allow_cross_dir) {
+    SuperBlock sb;
+    FileMetadata files[MAX_FILES];
+    if (load_metadata(&sb, files) < 0)
+         return -1;
+    int index = lookup_path(old_path, &sb, files);
+    if (index == -1 || index == FS_ROOT) {
+         std::cerr << op << ": Eski dosya bulunamadi\n";
+         return -1;
+    }
+    std::string leaf;
+    int16_t new_parent;
+    int target = lookup_path(new_path, &sb, files);
+    if (allow_cross_dir && (target == FS_ROOT || (target >= 0 && files[target].type == FS_TYPE_DIR))) {
+         // Hedef mevcut bir dizinse, girdi aynı isimle onun içine taşınır.
+         new_parent = target;
+         leaf = files[index].name;
+    } else if (!allow_cross_dir && strchr(new_path, '/') == NULL) {
+         new_parent = files[index].parent;
+         leaf = new_path;
+    } else {
+         int parent = resolve_parent(new_path, &sb, files, leaf);
+         if (parent == -1) {
+             std::cerr << op << ": Hedef dizin bulunamadi\n";
+             return -1;
+         }
+         new_parent = parent;
+    }
+    if (leaf.empty() || leaf.size() >= (size_t)MAX_NAME || leaf == "." || leaf == "..") {
+         std::cerr << op << ": Gecersiz hedef isim\n";
+         return -1;
+    }
+    if (!allow_cross_dir && new_parent != files[index].parent) {
+         std::cerr << op << ": Farkli dizine tasima icin fs_mv kullanin\n";
+         return -1;
+    }
+    if (dir_lookup(sb.dir_hash, files, new_parent, leaf.c_str()) != -1) {
+         std::cerr << op << ": Yeni isimde dosya zaten mevcut\n";
+         return -1;
+    }
+    // Bir dizin kendi alt ağacının içine taşınamaz.
+    for (int p = new_parent; p != FS_ROOT; p = files[p].parent) {
+         if (p == index) {
+             std::cerr << op << ": Dizin kendi altina tasinamaz\n";
+             return -1;
+         }
+    }
+    std::string old_full = entry_path(files, index);
+    dir_hash_remove(&sb, files, index);
+    files[index].parent = new_parent;
+    strncpy(files[index].name, leaf.c_str(), sizeof(files[index].name) - 1);
+    files[index].name[sizeof(files[index].name) - 1] = '\0';
+    dir_hash_insert(&sb, files, index);
+    if (files[index].type == FS_TYPE_DIR)
+         name_index_valid = false;  // Alt ağaçtaki tüm yollar değişir; indeks yeniden kurulacak.
+    else
+         name_index_apply(&sb, old_full, entry_path(files, index), index);
+    bump_generation(&sb);
+    return write_metadata(&sb, files);
+}
+
+//-------------------------
+// Paralel veri kopyalama
+//-------------------------
+
+// Paralel işlemlerde bir görevin kopyaladığı en büyük parça
+const size_t PARALLEL_CHUNK = 1024 * 1024;
+
+// src_fd'deki [src_offset, src_offset+size) aralığını dest_fd'ye dest_offset'ten itibaren
+// kopyalayan PARALLEL_CHUNK boyutlu görevleri tasks'e ekler. Hata olursa failed işaretlenir.
+static void add_copy_tasks(std::vector<std::function<void()>>& tasks, std::atomic<bool>& failed,
+                           int src_fd, off_t src_offset, int dest_fd, off_t dest_offset, size_t size) {
+    for (size_t done = 0; done < size; done += PARALLEL_CHUNK) {
+        size_t chunk = std::min(PARALLEL_CHUNK, size - done);
+        off_t from = src_offset + done;
+        off_t to = dest_offset + done;
+        tasks.push_back([&failed, src_fd, dest_fd, from, to, chunk]() {
+            std::vector<char> buffer(chunk);
+            if (!disk_pread(src_fd, buffer.data(), chunk, from) ||
+                !disk_pwrite(dest_fd, buffer.data(), chunk, to))
+                failed = true;
+        });
+    }
+}
+
+// Bir dosyanın tamamını paralel parçalar halinde diğerine kopyalar (yedekleme/geri yükleme).
+// Kaynaktaki delikler atlanır; hedef de seyrek kalır.
+static int parallel_copy_file(const char* op, int src_fd, int dest_fd) {
+    off_t size = disk_size(src_fd);
+    if (size < 0) {
+         perror((std::string(op) + ": boyut okunamadi").c_str());
+         return -1;
+    }
+    if (disk_truncate(dest_fd, size) < 0) {
+         perror((std::string(op) + ": hedef boyutu ayarlanamadi").c_str());
+         return -1;
+    }
+    // Hedef boyutlandırıldığında tamamen deliktir; yalnızca kaynaktaki veri aralıkları kopyalanır.
+    std::vector<std::pair<off_t, off_t>> segments;
+    disk_data_segments(src_fd, size, segments);
+    std::vector<std::function<void()>> tasks;
+    std::atomic<bool> failed(false);
+    for (size_t i = 0; i < segments.size(); i++) {
+         off_t length = segments[i].second - segments[i].first;
+         add_copy_tasks(tasks, failed, src_fd, segments[i].first, dest_fd, segments[i].first, length);
+    }
+    fs_parallel_run(tasks);
+    if (failed) {
+         perror((std::string(op) + ": kopyalama hatasi").c_str());
+         return -1;
+    }
+    return 0;
+}
+
+//-------------------------
+// Snapshot yardımcıları
+//-------------------------
+
+static off_t snapshot_table_offset(int slot) {
+    return sizeof(SuperBlock) + sizeof(FileMetadata) * MAX_FILES + (off_t)slot * sizeof(SnapshotTable);
+}
+
+static int read_snapshot_table(int slot, SnapshotTable* table) {
+    if (shared_metadata != NULL) {
+        shared_read([&] { memcpy(table, shared_metadata + snapshot_table_offset(slot), sizeof(SnapshotTable)); });
+        return 0;
+    }
+    int fd = disk_open(O_RDONLY);
+    if (fd < 0) {
+        perror("read_snapshot_table: disk.sim acilamadi");
+        return -1;
+    }
+    if (!disk_pread(fd, (char*)table, sizeof(SnapshotTable), snapshot_table_offset(slot))) {
+        perror("read_snapshot_table: okuma hatasi");
+        disk_close(fd);
+        return -1;
+    }
+    disk_close(fd);
+    return 0;
+}
+
+static int write_snapshot_table(int slot, const SnapshotTable* table) {
+    if (shared_metadata != NULL) {
+        shared_write_begin();
+        memcpy(shared_metadata + snapshot_table_offset(slot), table, sizeof(SnapshotTable));
+        shared_write_end();
+        return 0;
+    }
+    int fd = disk_open(O_RDWR);
+    if (fd < 0) {
+        perror("write_snapshot_table: disk.sim acilamadi");
+        return -1;
+    }
+    if (!disk_pwrite(fd, (const char*)table, sizeof(SnapshotTable), snapshot_table_offset(slot))) {
+        perror("write_snapshot_table: yazma hatasi");
+        disk_close(fd);
+        return -1;
+    }
+    disk_close(fd);
+    return 0;
+}
+
+// Geçerli tüm snapshot tablolarını slot numaralarıyla birlikte yükler
+static int load_snapshot_tables(const SuperBlock* sb, std::vector<int>& slots, std::vector<SnapshotTable>& tables) {
+    slots.clear();
+    tables.clear();
+    for (int i = 0; i < MAX_SNAPSHOTS; i++) {
+        if (!sb->snapshots[i].valid)
+            continue;
+        tables.push_back(SnapshotTable());
+        if (read_snapshot_table(i, &tables.back()) < 0)
+            return -1;
+        slots.push_back(i);
+    }
+    return 0;
+}
+
+static int find_snapshot(const SuperBlock* sb, const char* name) {
+    for (int i = 0; i < MAX_SNAPSHOTS; i++) {
+        if (sb->snapshots[i].valid && strcmp(sb->snapshots[i].name, name) == 0)
+            return i;
+    }
+    return -1;
+}
+
+// Tablodaki veri aralıklarını başlangıç -> boyut olarak ekler. Aralıklar ya ayrıktır
+// ya da (aynı verinin paylaşıldığı durumda) aynı başlangıca sahiptir.
+static void collect_extents(const FileMetadata files[], std::map<uint32_t, uint32_t>& extents) {
+    for (int i = 0; i < MAX_FILES; i++) {
+        if (files[i].valid && files[i].type == FS_TYPE_FILE && files[i].size > 0) {
+            uint32_t& size = extents[(uint32_t)files[i].start];
+            size = std::max(size, (uint32_t)files[i].size);
+        }
+    }
+}
+
+static bool table_references(const FileMetadata files[], uint32_t start) {
+    for (int i = 0; i < MAX_FILES; i++) {
+        if (files[i].valid && files[i].type == FS_TYPE_FILE && files[i].size > 0 && files[i].start == start)
+            return true;
+    }
+    return false;
+}
+
+// Snapshot'ların başvurduğu verinin bittiği offset (get_new_file_start bunun altına yazmaz)
+static uint32_t snapshot_data_end(const std::vector<SnapshotTable>& tables) {
+    uint32_t end = 0;
+    for (size_t t = 0; t < tables.size(); t++) {
+        for (int i = 0; i < MAX_FILES; i++) {
+            const FileMetadata& file = tables[t].files[i];
+            if (file.valid && file.type == FS_TYPE_FILE && file.start + file.size > end)
+                end = file.start + file.size;
+        }
+    }
+    return end;
+}
+
+// Canlı tablodan düşen bir veri aralığını, hiçbir snapshot ona başvurmuyorsa host'a iade eder.
+// Çağıran extent_mutex'i özel olarak tutmalıdır.
+static void release_file_extent(const SuperBlock* sb, uint32_t start, uint32_t size) {
+    if (size == 0)
+        return;
+    // snapshot_end'in altındaki aralıklar bir snapshot'a ait olabilir.
+    if (start < sb->snapshot_end) {
+        std::vector<int> slots;
+        std::vector<SnapshotTable> tables;
+        if (load_snapshot_tables(sb, slots, tables) < 0)
+            return;
+        for (size_t t = 0; t < tables.size(); t++) {
+            if (table_references(tables[t].files, start))
+                return;
+        }
+    }
+    release_extent(start, size);
+}
+
+//-------------------------
+// Geri yazma (write-back) tamponu
+//-------------------------
+
+// Küçük fs_write/fs_append'ler hemen yer ayırmaz; dosya başına bellekte biriktirilir.
+// Yer yalnızca boşaltmada (fs_fsync/fs_sync, bellek sınırı, zamanlayıcı veya veri alanını
+// doğrudan kullanan bir işlem) ayrılır ve boşaltılan dosyalar ardışık tek bir alana, tek
+// yazmayla yerleştirilir. Tamponlar fs_mutex ile korunur.
+const int WRITE_BACK_MAX_WRITE = 64 * 1024;     // Bundan büyük dosya tamponları hemen boşaltılır
+const size_t WRITE_BACK_LIMIT = 1024 * 1024;    // Tüm tamponların toplam bellek sınırı
+const std::chrono::milliseconds WRITE_BACK_DELAY(200);  // Bir tamponun bellekte kalabileceği süre
+
+struct PendingWrite {
+    bool replace;                             // true: fs_write, içerik tamamen data'dır
+    std::vector<char> data;                   // false: diskteki içeriğin sonuna eklenecek veri
+    std::chrono::steady_clock::time_point since;
+};
+
+static std::map<int, PendingWrite> write_back;  // Metadata indeksi -> bekleyen veri
+static size_t write_back_bytes = 0;
+static std::thread flush_thread;
+static std::condition_variable_any flush_cv;
+static bool flush_stopping = false;
+
+// Tampon boşaltıldığında dosyanın sahip olacağı içerik boyutu
+static uint32_t pending_content_size(const FileMetadata files[], int index, const PendingWrite& pending) {
+    return (pending.replace ? 0 : files[index].size) + pending.data.size();
+}
+
+// Bekleyen yazmalar dahil dosya boyutu (fs_size, fs_list, fs_readdir)
+static uint32_t effective_size(const FileMetadata files[], int index) {
+    auto it = write_back.find(index);
+    return it == write_back.end() ? files[index].size : pending_content_size(files, index, it->second);
+}
+
+static void discard_write_back(int index) {
+    auto it = write_back.find(index);
+    if (it == write_back.end())
+        return;
+    write_back_bytes -= it->second.data.size();
+    write_back.erase(it);
+}
+
+static void discard_all_write_back() {
+    write_back.clear();
+    write_back_bytes = 0;
+}
+
+// Verilen dosyaların tamponlarını boşaltır: yeni içerikler ardışık bir alana dizilir, tek
+// disk_pwrite ile yazılır ve metadata bir kez güncellenir. Hata olursa tamponlar korunur.
+static int flush_write_back(const std::vector<int>& indices) {
+    if (indices.empty())
+        return 0;
+    FsWriteLock lock;  // Zamanlayıcıdan çağrıldığında yazıcı kilidi burada alınır.
+    if (!lock.locked())
+        return -1;
+    SuperBlock sb;
+    FileMetadata files[MAX_FILES];
+    if (load_metadata(&sb, files) < 0)
+        return -1;
+    std::vector<uint32_t> offsets;
+    uint32_t total = 0;
+    for (size_t i = 0; i < indices.size(); i++) {
+        offsets.push_back(total);
+        total += pending_content_size(files, indices[i], write_back[indices[i]]);
+    }
+    uint32_t start = get_new_file_start(&sb, files, total);
+    if (start == 0) {
+        std::cerr << "flush_write_back: Yeterli alan yok\n";
+        return -1;
+    }
+    std::vector<char> buffer(total);
+    std::unique_lock<std::shared_mutex> extents(extent_mutex);
+    int fd = disk_open(O_RDWR);
+    if (fd < 0) {
+        perror("flush_write_back: disk.sim acilamadi");
+        return -1;
+    }
+    for (size_t i = 0; i < indices.size(); i++) {
+        const FileMetadata& file = files[indices[i]];
+        const PendingWrite& pending = write_back[indices[i]];
+        char* out = buffer.data() + offsets[i];
+        if (!pending.replace && file.size > 0) {
+            if (!disk_pread(fd, out, file.size, file.start)) {
+                perror("flush_write_back: okuma hatasi");
+                disk_close(fd);
+                return -1;
+            }
+            out += file.size;
+        }
+        memcpy(out, pending.data.data(), pending.data.size());
+    }
+    if (!disk_pwrite(fd, buffer.data(), total, start)) {
+        perror("flush_write_back: yazma hatasi");
+        disk_close(fd);
+        return -1;
+    }
+    disk_close(fd);
+    std::vector<std::pair<uint32_t, uint32_t>> old_extents;
+    for (size_t i = 0; i < indices.size(); i++) {
+        FileMetadata& file = files[indices[i]];
+        old_extents.push_back(std::make_pair((uint32_t)file.start, (uint32_t)file.size));
+        file.start = start + offsets[i];
+        file.size = pending_content_size(files, indices[i], write_back[indices[i]]);
+        file.content_hash_valid = 0;
+    }
+    if (write_metadata(&sb, files) < 0)
+        return -1;
+    for (size_t i = 0; i < indices.size(); i++) {
+        release_file_extent(&sb, old_extents[i].first, old_extents[i].second);
+        discard_write_back(indices[i]);
+    }
+    return 0;
+}
+
+// Tüm tamponları boşaltır; veri alanını doğrudan okuyan veya yer ayıran işlemler önce bunu çağırır.
+static int flush_all_write_back() {
+    std::vector<int> indices;
+    for (auto it = write_back.begin(); it != write_back.end(); ++it)
+        indices.push_back(it->first);
+    return flush_write_back(indices);
+}
+
+// Zamanlayıcı: süresi dolan tamponları arka planda boşaltır.
+static void flush_timer() {
+    std::unique_lock<std::recursive_mutex> lock(fs_mutex);
+    while (!flush_stopping) {
+        flush_cv.wait_for(lock, WRITE_BACK_DELAY);
+        std::vector<int> expired;
+        auto now = std::chrono::steady_clock::now();
+        for (auto it = write_back.begin(); it != write_back.end(); ++it) {
+            if (now - it->second.since >= WRITE_BACK_DELAY)
+                expired.push_back(it->first);
+        }
+        flush_write_back(expired);
+    }
+}
+
+// Çıkışta zamanlayıcı durdurulur ve kalan tamponlar diske yazılır. Asenkron kuyruk
+// önce boşaltılır; kuyruktaki eklemeler tamponlara yazabilir ve atexit sırası,
+// fs_async_shutdown'ın bundan önce çalışacağını garanti etmez.
+static void stop_flush_timer() {
+    fs_async_shutdown();
+    {
+        std::lock_guard<std::recursive_mutex> lock(fs_mutex);
+        flush_stopping = true;
+    }
+    flush_cv.notify_all();
+    if (flush_thread.joinable())
+        flush_thread.join();
+    std::lock_guard<std::recursive_mutex> lock(fs_mutex);
+    flush_all_write_back();
+}
+
+// fork: çocuk süreç zamanlayıcı iş parçacığını devralmaz ve ebeveynin tamponlarını ikinci
+// kez yazmamalıdır. Fork boyunca fs_mutex tutulur ki tamponlar yarım değişmiş kopyalanmasın.
+static void fork_prepare() {
+    fs_mutex.lock();
+}
+
+static void fork_parent() {
+    fs_mutex.unlock();
+}
+
+static void fork_child() {
+    // Kilidin sahibi ebeveyndeki iş parçacığı kimliğiyle kayıtlıdır; çocukta bırakılamadığı
+    // için yeniden kurulur. Çocukta karşılığı olmayan zamanlayıcı da join edilmeden unutulur.
+    new (&fs_mutex) std::recursive_mutex();
+    new (&flush_thread) std::thread();
+    new (&flush_cv) std::condition_variable_any();
+    discard_all_write_back();
+}
+
+static void start_flush_timer() {
+    static bool handlers_registered = false;
+    if (flush_thread.joinable() || flush_stopping)
+        return;
+    // Boşaltma iş çalan havuzu kullanabilir; havuzun atexit kaydı önce yapılır ki çıkışta
+    // havuz, stop_flush_timer'dan sonra kapatılsın.
+    fs_get_parallelism();
+    flush_thread = std::thread(flush_timer);
+    if (!handlers_registered) {
+        atexit(stop_flush_timer);
+        pthread_atfork(fork_prepare, fork_parent, fork_child);
+        handlers_registered = true;
+    }
+}
+
+// Veriyi dosyanın tamponuna ekler (replace: fs_write). Boşaltmada tüm tamponların ardışık
+// yerleşebilmesi için gereken alan şimdiden kontrol edilir; yer yoksa hiçbir şey tamponlanmaz.
+static int buffer_write(const char* op, const SuperBlock* sb, FileMetadata files[], int index,
+                        const char* data, int size, bool replace) {
+    uint32_t reserved = replace ? size : effective_size(files, index) + size;
+    for (auto it = write_back.begin(); it != write_back.end(); ++it) {
+        if (it->first != index)
+            reserved += pending_content_size(files, it->first, it->second);
+    }
+    if (get_new_file_start(sb, files, reserved) == 0) {
+        std::cerr << op << ": Yeterli alan yok\n";
+        return -1;
+    }
+    auto it = write_back.find(index);
+    if (it == write_back.end()) {
+        PendingWrite pending;
+        pending.replace = replace;
+        pending.since = std::chrono::steady_clock::now();
+        it = write_back.insert(std::make_pair(index, pending)).first;
+    } else if (replace) {
+        write_back_bytes -= it->second.data.size();
+        it->second.data.clear();
+        it->second.replace = true;
+    }
+    it->second.data.insert(it->second.data.end(), data, data + size);
+    write_back_bytes += size;
+    // Paylaşımlı modda tampon başka süreçlere görünmez ve ayrılan yer onlar tarafından
+    // kullanılabilir; çıkışta zamanlayıcı durdurulduktan sonra ise tamponu boşaltacak
+    // kimse kalmaz. Bu durumlarda veri hemen diske yazılır.
+    if (shared_metadata != NULL || flush_stopping || it->second.data.size() > (size_t)WRITE_BACK_MAX_WRITE)
+        return flush_write_back(std::vector<int>(1, index));
+    if (write_back_bytes > WRITE_BACK_LIMIT)
+        return flush_all_write_back();
+    start_flush_timer();
+    return 0;
+}
+
+// Asenkron kuyruk, toplu istekleri disk konumuna göre sıralamak için kullanır.
+void fs_data_offsets(const char* const filenames[], const int offsets[], uint32_t out[], int count) {
+    std::lock_guard<std::recursive_mutex> lock(fs_mutex);
+    SuperBlock sb;
+    FileMetadata files[MAX_FILES];
+    bool loaded = load_metadata(&sb, files) == 0;
+    for (int i = 0; i < count; i++) {
+        int index = loaded ? find_file_index(filenames[i], &sb, files) : -1;
+        out[i] = (index == -1) ? UINT32_MAX : files[index].start + offsets[i];
+    }
+}
+
 //-------------------------
 // Fonksiyonlar
 //-------------------------
 
 // fs_format: Disk içeriğini sıfırların ve boş metadata ile doldurarak formatlar.
 int fs_format() {
-    int fd = open(DISK_FILENAME, O_RDWR | O_CREAT, 0666);
+    FsWriteLock lock;
+    if (!lock.locked())
+         return -1;
+    std::unique_lock<std::shared_mutex> extents(extent_mutex);
+    SharedWriteSection section;
+    int fd = disk_open(O_RDWR | O_CREAT, 0666);
     if (fd < 0) {
          perror("fs_format: disk.sim acilamadi");
          return -1;
     }
-    if (ftruncate(fd, DISK_SIZE) < 0) {
+    // Önce sıfır boyuta indirip yeniden büyütmek eski veriyi atar ve seyrek bir imaj bırakır.
+    // Paylaşımlı modda metadata alanı diğer süreçlerde eşli olduğundan (kesilirse SIGBUS)
+    // yalnızca veri alanı atılır; metadata aşağıda tümüyle yeniden yazılır.
+    off_t keep = shared_metadata != NULL ? METADATA_SIZE : 0;
+    if (disk_truncate(fd, keep) < 0 || disk_truncate(fd, disk_capacity()) < 0) {
          perror("fs_format: diskin boyutu ayarlanamadi");
-         close(fd);
+         disk_close(fd);
+         return -1;
+    }
+    SuperBlock sb;
+    memset(&sb, 0, sizeof(sb));
+    sb.magic = FS_MAGIC;
+    sb.version = FS_VERSION;
+    sb.file_count = 0;
+    sb.generation = (uint32_t)time(NULL);  // Önceki formatlardan kalan dentry cache'leri geçersiz kılar
+    for (int i = 0; i < DIR_HASH_SIZE; i++)
+         sb.dir_hash[i] = -1;
+    sb.volume_id = sb.generation;
+    sb.member_count = (uint16_t)disk_member_count();
+    sb.stripe_unit = disk_stripe_unit();
+    if (disk_write_labels(fd, sb.volume_id) < 0) {
+         perror("fs_format: imaj etiketleri yazilamadi");
+         disk_close(fd);
          return -1;
     }
-    int file_count = 0;
     FileMetadata files[MAX_FILES];
     memset(files, 0, sizeof(files));
-    if (lseek(fd, 0, SEEK_SET) < 0) {
-         perror("fs_format: lseek hatasi");
-         close(fd);
+    disk_close(fd);
+    if (write_metadata(&sb, files) < 0)
+         return -1;
+    discard_all_write_back();
+    dentry_invalidate();
+    name_index_valid = false;
+    fs_log("Disk formatlandi");
+    return 0;
+}
+
+static std::vector<std::string> image_list(const char* const images[], int count) {
+    std::vector<std::string> list;
+    for (int i = 0; i < count; i++)
+         list.push_back(images[i]);
+    return list;
+}
+
+// fs_format_volume: Verilen imajlardan bir birim oluşturur ve formatlar. Veri alanı
+// stripe_unit (<= 0: varsayılan) boyutlu parçalar halinde imajlara sırayla dağıtılır;
+// düzen süper blokta saklanır. Hata olursa önceki birim geçerli kalır.
+int fs_format_volume(const char* const images[], int count, int stripe_unit) {
+    // extent_mutex'i fs_format alır; açık tanıtıcılar açıldıkları andaki düzeni kullanmaya devam eder.
+    FsWriteLock lock;
+    if (!lock.locked())
+         return -1;
+    // Diğer süreçler eşlemeyi eski birimin imajı üzerinde tutar.
+    if (shared_metadata != NULL) {
+         std::cerr << "fs_format_volume: Paylasimli metadata modunda birim degistirilemez\n";
          return -1;
     }
-    if (write(fd, &file_count, sizeof(int)) != sizeof(int)) {
-         perror("fs_format: file_count yazilamadi");
-         close(fd);
+    if (flush_all_write_back() < 0)
+         return -1;
+    std::vector<std::string> old_images;
+    uint32_t old_unit;
+    disk_get_volume(old_images, old_unit);
+    uint32_t unit = stripe_unit > 0 ? (uint32_t)stripe_unit : DEFAULT_STRIPE_UNIT;
+    if (count <= 0 || disk_set_volume(image_list(images, count), unit) < 0)
+         return -1;
+    if (fs_format() < 0) {
+         disk_set_volume(old_images, old_unit);
          return -1;
     }
-    if (write(fd, files, sizeof(files)) != sizeof(files)) {
-         perror("fs_format: metadata yazilamadi");
-         close(fd);
+    fs_log((std::string("Birim formatlandi: ") + std::to_string(count) + " imaj, serit " +
+            std::to_string(unit) + " byte").c_str());
+    return 0;
+}
+
+// fs_mount: Daha önce formatlanmış bir birimi bağlar. İmajlar formatlamadaki sırayla
+// verilmelidir; düzen süper bloktan okunur ve diğer imajların etiketleriyle doğrulanır.
+int fs_mount(const char* const images[], int count) {
+    FsWriteLock lock;
+    if (!lock.locked())
+         return -1;
+    // Diğer süreçler eşlemeyi eski birimin imajı üzerinde tutar.
+    if (shared_metadata != NULL) {
+         std::cerr << "fs_mount: Paylasimli metadata modunda birim degistirilemez\n";
          return -1;
     }
-    close(fd);
-    fs_log("Disk formatlandi");
+    if (flush_all_write_back() < 0)
+         return -1;
+    std::unique_lock<std::shared_mutex> extents(extent_mutex);
+    std::vector<std::string> old_images;
+    uint32_t old_unit;
+    disk_get_volume(old_images, old_unit);
+    if (count <= 0 || disk_set_volume(image_list(images, count), DEFAULT_STRIPE_UNIT) < 0)
+         return -1;
+    // Süper blok şeritlenmeyen metadata alanındadır; kayıtlı şerit boyu bilinmeden okunabilir.
+    SuperBlock sb;
+    FileMetadata files[MAX_FILES];
+    int result = -1;
+    if (load_metadata(&sb, files) == 0) {
+         if (sb.member_count != count) {
+             std::cerr << "fs_mount: Birim " << sb.member_count << " imajdan olusuyor\n";
+         } else if (disk_set_volume(image_list(images, count), sb.stripe_unit) == 0) {
+             int fd = disk_open(O_RDONLY);
+             if (fd >= 0) {
+                 result = disk_check_labels(fd, sb.volume_id);
+                 disk_close(fd);
+             }
+         }
+    }
+    if (result < 0) {
+         disk_set_volume(old_images, old_unit);
+         return -1;
+    }
+    dentry_invalidate();
+    name_index_valid = false;
+    fs_log((std::string("Birim baglandi: ") + std::to_string(count) + " imaj").c_str());
     return 0;
 }
 
 // fs_create: Yeni bir dosya oluşturur ve metadata’ya kayıt ekler.
 int fs_create(const char* filename) {
+    FsWriteLock lock;
+    if (!lock.locked())
+         return -1;
+    SuperBlock sb;
     FileMetadata files[MAX_FILES];
-    int file_count;
-    if (load_metadata(files, &file_count) < 0)
+    if (load_metadata(&sb, files) < 0)
          return -1;
-    if (find_file_index(filename, files, file_count) != -1) {
+    if (lookup_path(filename, &sb, files) != -1) {
          std::cerr << "fs_create: Dosya zaten mevcut\n";
          return -1;
     }
-    int index = -1;
-    for (int i = 0; i < MAX_FILES; i++) {
-        if (!files[i].valid) {
-            index = i;
-            break;
-        }
+    std::string leaf;
+    int parent = resolve_parent(filename, &sb, files, leaf);
+    if (parent == -1) {
+         std::cerr << "fs_create: Ust dizin bulunamadi veya gecersiz isim\n";
+         return -1;
     }
+    int index = find_free_slot(files);
     if (index == -1) {
          std::cerr << "fs_create: Bos metadata slotu yok\n";
          return -1;
     }
-    uint32_t new_start = get_new_file_start(files, file_count, 0);  // Boyut 0, henüz veri yok
+    uint32_t new_start = get_new_file_start(&sb, files, 0);  // Boyut 0, henüz veri yok
     if (new_start == 0) {
          std::cerr << "fs_create: Yeni dosya icin yer ayrilmadi\n";
          return -1;
     }
-    files[index].valid = 1;
-    strncpy(files[index].name, filename, sizeof(files[index].name) - 1);
-    files[index].name[sizeof(files[index].name) - 1] = '\0';
+    link_entry(&sb, files, index, parent, leaf, FS_TYPE_FILE);
     files[index].size = 0;
     files[index].start = new_start;
-    files[index].creationTime = time(NULL);
-    file_count++;
-    if (write_metadata(files, file_count) < 0)
+    if (write_metadata(&sb, files) < 0)
          return -1;
     fs_log((std::string("Dosya olusturuldu: ") + filename).c_str());
     return 0;
@@ -167,225 +1267,351 @@ int fs_create(const char* filename) {
 
 // fs_delete: Belirtilen dosyayı siler, metadata’da geçersiz kılar.
 int fs_delete(const char* filename) {
+    FsWriteLock lock;
+    if (!lock.locked())
+         return -1;
+    SuperBlock sb;
     FileMetadata files[MAX_FILES];
-    int file_count;
-    if (load_metadata(files, &file_count) < 0)
+    if (load_metadata(&sb, files) < 0)
          return -1;
-    int index = find_file_index(filename, files, file_count);
+    int index = find_file_index(filename, &sb, files);
     if (index == -1) {
          std::cerr << "fs_delete: Dosya bulunamadi\n";
          return -1;
     }
-    files[index].valid = 0;
-    file_count--;
-    if (write_metadata(files, file_count) < 0)
+    unlink_entry(&sb, files, index);
+    if (write_metadata(&sb, files) < 0)
          return -1;
+    discard_write_back(index);  // Henüz yer ayrılmamış veri diske hiç yazılmaz.
+    std::unique_lock<std::shared_mutex> extents(extent_mutex);
+    release_file_extent(&sb, files[index].start, files[index].size);
     fs_log((std::string("Dosya silindi: ") + filename).c_str());
     return 0;
 }
 
 // fs_write: Dosyanın içeriğini, verilen veri ile (eski içeriğin üzerine) yazar.
 int fs_write(const char* filename, const char* data, int size) {
+    FsWriteLock lock;
+    if (!lock.locked())
+         return -1;
+    SuperBlock sb;
     FileMetadata files[MAX_FILES];
-    int file_count;
-    if (load_metadata(files, &file_count) < 0)
+    if (load_metadata(&sb, files) < 0)
          return -1;
-    int index = find_file_index(filename, files, file_count);
+    int index = find_file_index(filename, &sb, files);
     if (index == -1) {
          std::cerr << "fs_write: Dosya bulunamadi\n";
          return -1;
     }
-    uint32_t new_start = get_new_file_start(files, file_count, size);
+    if (size <= WRITE_BACK_MAX_WRITE) {
+         if (buffer_write("fs_write", &sb, files, index, data, size, true) < 0)
+             return -1;
+         fs_log((std::string("Veri yazldi: ") + filename).c_str());
+         return 0;
+    }
+    // Büyük yazmalar tamponlanmadan doğrudan yazılır; dosyanın bekleyen verisi artık geçersizdir.
+    discard_write_back(index);
+    if (flush_all_write_back() < 0 || load_metadata(&sb, files) < 0)
+         return -1;
+    uint32_t new_start = get_new_file_start(&sb, files, size);
     if (new_start == 0) {
          std::cerr << "fs_write: Yeterli alan yok\n";
          return -1;
     }
-    int fd = open(DISK_FILENAME, O_RDWR);
+    std::unique_lock<std::shared_mutex> extents(extent_mutex);
+    int fd = disk_open(O_RDWR);
     if (fd < 0) {
          perror("fs_write: disk.sim acilamadi");
          return -1;
     }
-    if (lseek(fd, new_start, SEEK_SET) < 0) {
-         perror("fs_write: lseek hatasi");
-         close(fd);
-         return -1;
-    }
-    if (write(fd, data, size) != size) {
+    if (!disk_pwrite(fd, data, size, new_start)) {
          perror("fs_write: yazma hatasi");
-         close(fd);
+         disk_close(fd);
          return -1;
     }
-    close(fd);
+    disk_close(fd);
+    uint32_t old_start = files[index].start, old_size = files[index].size;
     files[index].start = new_start;
     files[index].size = size;
-    if (write_metadata(files, file_count) < 0)
+    files[index].content_hash_valid = 0;
+    if (write_metadata(&sb, files) < 0)
          return -1;
+    release_file_extent(&sb, old_start, old_size);
     fs_log((std::string("Veri yazldi: ") + filename).c_str());
     return 0;
 }
 
-// fs_read: Dosyadan, belirtilen offset'ten başlayarak, istenen boyutta veri okur.
-int fs_read(const char* filename, int offset, int size, char* buffer) {
+// Paylaşımlı modda dosyanın, okuma başladığındaki konumda durup durmadığını kontrol eder.
+// Başka bir süreç dosyayı yeniden yazıp eski alanı serbest bırakmış olabilir.
+static bool extent_unchanged(int index, const FileMetadata& file) {
+    FileMetadata current;
+    shared_read([&] {
+        memcpy(&current, shared_metadata + sizeof(SuperBlock) + sizeof(FileMetadata) * index, sizeof(FileMetadata));
+    });
+    return current.valid && current.start == file.start && current.size == file.size;
+}
+
+static int read_file(const char* filename, int offset, int size, char* buffer, bool* moved) {
+    std::unique_lock<std::recursive_mutex> lock(fs_mutex);
+    SuperBlock sb;
     FileMetadata files[MAX_FILES];
-    int file_count;
-    if (load_metadata(files, &file_count) < 0)
+    if (load_metadata(&sb, files) < 0)
          return -1;
-    int index = find_file_index(filename, files, file_count);
+    int index = find_file_index(filename, &sb, files);
     if (index == -1) {
          std::cerr << "fs_read: Dosya bulunamadi\n";
          return -1;
     }
-    if (offset + size > (int)files[index].size) {
+    if (offset + size > (int)effective_size(files, index)) {
          std::cerr << "fs_read: Okuma, dosya boyutunu asiyor\n";
          return -1;
     }
-    int fd = open(DISK_FILENAME, O_RDONLY);
+    // Henüz diske yazılmamış kısım tampondan kopyalanır; diskteki içerik tamponun önünde yer alır.
+    int disk_part = size;
+    auto pending = write_back.find(index);
+    if (pending != write_back.end()) {
+         int disk_size = pending->second.replace ? 0 : files[index].size;
+         disk_part = std::max(0, std::min(size, disk_size - offset));
+         memcpy(buffer + disk_part, pending->second.data.data() + (offset + disk_part - disk_size), size - disk_part);
+    }
+    if (disk_part == 0)
+         return size;
+    // Konum bulundu; veri okunurken metadata kilidi bırakılır, yalnızca veri alanı kilitli kalır.
+    std::shared_lock<std::shared_mutex> extents(extent_mutex);
+    lock.unlock();
+    int fd = disk_open(O_RDONLY);
     if (fd < 0) {
          perror("fs_read: disk.sim acilamadi");
          return -1;
     }
-    if (lseek(fd, files[index].start + offset, SEEK_SET) < 0) {
-         perror("fs_read: lseek hatasi");
-         close(fd);
-         return -1;
-    }
-    if (read(fd, buffer, size) != size) {
+    if (!disk_pread(fd, buffer, disk_part, files[index].start + offset)) {
          perror("fs_read: okuma hatasi");
-         close(fd);
+         disk_close(fd);
          return -1;
     }
-    close(fd);
+    disk_close(fd);
+    if (moved != NULL && shared_metadata != NULL) {
+         // Bu süreçteki yazıcılar veri alanı kilitliyken alanı serbest bırakamaz; yalnızca
+         // diğer süreçlerin değişiklikleri kontrol edilir.
+         extents.unlock();
+         lock.lock();
+         *moved = !extent_unchanged(index, files[index]);
+    }
     return size;
 }
 
-// fs_ls: Diskteki tüm dosyaların isimlerini ve boyutlarını listeler.
+// fs_read: Dosyadan, belirtilen offset'ten başlayarak, istenen boyutta veri okur.
+int fs_read(const char* filename, int offset, int size, char* buffer) {
+    // Paylaşımlı modda okuma sırasında dosya taşınmışsa okuma tekrarlanır; sürekli
+    // taşınıyorsa diğer süreçlerin yazıcıları durdurularak okunur.
+    for (int attempt = 0; attempt < SHARED_READ_ATTEMPTS; attempt++) {
+         bool moved = false;
+         int result = read_file(filename, offset, size, buffer, &moved);
+         if (result < 0 || !moved)
+             return result;
+    }
+    FsWriteLock lock;
+    if (!lock.locked())
+         return -1;
+    return read_file(filename, offset, size, buffer, NULL);
+}
+
+// fs_ls geri çağırması: girdileri ekrana yazdırır
+static int print_list_entry(const FsListEntry* entry, void* ctx) {
+    if (entry->type == FS_TYPE_DIR)
+        std::cout << "Dizin: " << entry->path << "/\n";
+    else
+        std::cout << "Dosya: " << entry->path << ", Boyut: " << entry->size << " bytes\n";
+    return 0;
+}
+
+// fs_ls: Diskteki tüm dosyaların ve dizinlerin tam yollarını ve boyutlarını, yola göre sıralı listeler.
 int fs_ls() {
-    FileMetadata files[MAX_FILES];
-    int file_count;
-    if (load_metadata(files, &file_count) < 0)
-         return -1;
+    std::lock_guard<std::recursive_mutex> lock(fs_mutex);
     std::cout << "Dosya Listesi:\n";
-    for (int i = 0; i < MAX_FILES; i++) {
-        if (files[i].valid) {
-            std::cout << "Dosya: " << files[i].name << ", Boyut: " << files[i].size << " bytes\n";
-        }
-    }
+    if (fs_list(NULL, print_list_entry, NULL, NULL, 0) < 0)
+         return -1;
     fs_log("Dosyalar listelendi");
     return 0;
 }
 
-// fs_rename: Dosyanın ismini değiştirir, metadata’da güncelleme yapar.
-int fs_rename(const char* old_name, const char* new_name) {
+// '/' ile başlamayan filtre değerlerini tam yola çevirir
+static std::string list_key(const char* value) {
+    if (value == NULL)
+        return "";
+    return value[0] == '/' ? std::string(value) : "/" + std::string(value);
+}
+
+// fs_list: Sıralı isim indeksi üzerinden önek/aralık filtreli, sayfalı listeleme yapar.
+// Her girdi için cb çağrılır; listelenen girdi sayısını döner. Sayfa limiti dolduğunda
+// ve devamı varsa next_cursor'a bir sonraki çağrıda kullanılacak imleç yazılır, aksi halde boş kalır.
+// Listeleme log'a yazılmaz.
+int fs_list(const FsListOptions* opts, fs_list_cb cb, void* ctx, char* next_cursor, int cursor_size) {
+    std::lock_guard<std::recursive_mutex> lock(fs_mutex);
+    SuperBlock sb;
     FileMetadata files[MAX_FILES];
-    int file_count;
-    if (load_metadata(files, &file_count) < 0)
-         return -1;
-    int index = find_file_index(old_name, files, file_count);
-    if (index == -1) {
-         std::cerr << "fs_rename: Eski dosya bulunamadi\n";
-         return -1;
-    }
-    if (find_file_index(new_name, files, file_count) != -1) {
-         std::cerr << "fs_rename: Yeni isimde dosya zaten mevcut\n";
+    if (load_metadata(&sb, files) < 0)
+         return -1;
+    if (next_cursor != NULL && cursor_size > 0)
+         next_cursor[0] = '\0';
+    name_index_sync(&sb, files);
+    std::string prefix = opts ? list_key(opts->prefix) : "";
+    std::string range_end = opts ? list_key(opts->range_end) : "";
+    int limit = opts ? opts->limit : 0;
+    // Başlangıç noktası: önek, aralık başı ve imlecin en büyüğü.
+    std::string from = prefix;
+    bool exclusive = false;
+    if (opts && opts->range_start && list_key(opts->range_start) > from)
+         from = list_key(opts->range_start);
+    if (opts && opts->cursor && opts->cursor[0] && list_key(opts->cursor) >= from) {
+         from = list_key(opts->cursor);
+         exclusive = true;
+    }
+    auto it = std::lower_bound(name_index.begin(), name_index.end(), NameIndexEntry(from, -1));
+    while (exclusive && it != name_index.end() && it->first == from)
+         ++it;
+    // Sayfa önce kopyalanır: geri çağırma fs_* fonksiyonlarını çağırıp indeksi
+    // değiştirebileceği için indeks üzerindeki yineleyiciler çağrı boyunca tutulmaz.
+    std::vector<std::string> paths;
+    std::vector<FsListEntry> page;
+    std::string cursor;
+    for (; it != name_index.end(); ++it) {
+        if (it->first.compare(0, prefix.size(), prefix) != 0)
+            break;
+        if (!range_end.empty() && it->first >= range_end)
+            break;
+        if (limit > 0 && (int)page.size() == limit) {
+            // Sayfa doldu ve devamı var: imleç, sayfadaki son yoldur.
+            cursor = paths.back();
+            break;
+        }
+        const FileMetadata& file = files[it->second];
+        FsListEntry entry;
+        entry.type = file.type;
+        entry.size = file.type == FS_TYPE_FILE ? effective_size(files, it->second) : file.size;
+        paths.push_back(it->first);
+        page.push_back(entry);
+    }
+    int count = 0;
+    for (size_t i = 0; i < page.size(); i++) {
+        page[i].path = paths[i].c_str();
+        count++;
+        if (cb != NULL && cb(&page[i], ctx) != 0)
+            return count;
+    }
+    if (!cursor.empty() && next_cursor != NULL && cursor_size > 0) {
+        strncpy(next_cursor, cursor.c_str(), cursor_size - 1);
+        next_cursor[cursor_size - 1] = '\0';
+    }
+    return count;
+}
+
+// fs_rename: Girdinin ismini aynı dizin içinde değiştirir, metadata’da güncelleme yapar.
+int fs_rename(const char* old_name, const char* new_name) {
+    FsWriteLock lock;
+    if (!lock.locked())
          return -1;
-    }
-    strncpy(files[index].name, new_name, sizeof(files[index].name)-1);
-    files[index].name[sizeof(files[index].name)-1] = '\0';
-    if (write_metadata(files, file_count) < 0)
+    if (move_entry("fs_rename", old_name, new_name, false) < 0)
          return -1;
     fs_log((std::string("Dosya yeniden adlandirildi: ") + old_name + " -> " + new_name).c_str());
     return 0;
 }
 
-// fs_exists: Dosyanın var olup olmadığını kontrol eder (1/0 olarak döner).
+// fs_exists: Dosyanın veya dizinin var olup olmadığını kontrol eder (1/0 olarak döner).
 int fs_exists(const char* filename) {
+    std::lock_guard<std::recursive_mutex> lock(fs_mutex);
+    SuperBlock sb;
     FileMetadata files[MAX_FILES];
-    int file_count;
-    if (load_metadata(files, &file_count) < 0)
+    if (load_metadata(&sb, files) < 0)
          return 0;
-    int index = find_file_index(filename, files, file_count);
+    int index = lookup_path(filename, &sb, files);
     return (index != -1) ? 1 : 0;
 }
 
 // fs_size: Dosyanın boyutunu metadata'dan döner.
 int fs_size(const char* filename) {
+    std::lock_guard<std::recursive_mutex> lock(fs_mutex);
+    SuperBlock sb;
     FileMetadata files[MAX_FILES];
-    int file_count;
-    if (load_metadata(files, &file_count) < 0)
+    if (load_metadata(&sb, files) < 0)
          return -1;
-    int index = find_file_index(filename, files, file_count);
+    int index = find_file_index(filename, &sb, files);
     if (index == -1) {
          std::cerr << "fs_size: Dosya bulunamadi\n";
          return -1;
     }
-    return files[index].size;
+    return effective_size(files, index);
 }
 
 // fs_append: Dosyanın mevcut içeriğinin sonuna, veriyi ekler.
-// Uygulamada, dosyanın eski içeriğini okuyup, ekleyeceğimiz veriyi yeni bir alana topluca yazıyoruz.
+// Veri önce dosyanın geri yazma tamponunda birikir; boşaltmada dosyanın eski içeriği ile
+// biriken veri yeni bir alana topluca yazılır.
 int fs_append(const char* filename, const char* data, int size) {
+    FsWriteLock lock;
+    if (!lock.locked())
+         return -1;
+    SuperBlock sb;
     FileMetadata files[MAX_FILES];
-    int file_count;
-    if (load_metadata(files, &file_count) < 0)
+    if (load_metadata(&sb, files) < 0)
          return -1;
-    int index = find_file_index(filename, files, file_count);
+    int index = find_file_index(filename, &sb, files);
     if (index == -1) {
          std::cerr << "fs_append: Dosya bulunamadi\n";
          return -1;
     }
-    int old_size = files[index].size;
-    int new_total_size = old_size + size;
-    char* temp = new char[new_total_size];
-    if (old_size > 0) {
-         if (fs_read(filename, 0, old_size, temp) < 0) {
-             delete[] temp;
-             return -1;
-         }
-    }
-    memcpy(temp + old_size, data, size);
-    uint32_t new_start = get_new_file_start(files, file_count, new_total_size);
-    if (new_start == 0) {
-         std::cerr << "fs_append: Yeterli alan yok\n";
-         delete[] temp;
+    if (buffer_write("fs_append", &sb, files, index, data, size, false) < 0)
          return -1;
-    }
-    int fd = open(DISK_FILENAME, O_RDWR);
-    if (fd < 0) {
-         perror("fs_append: disk.sim acilamadi");
-         delete[] temp;
+    fs_log((std::string("Veri eklendi: ") + filename).c_str());
+    return 0;
+}
+
+// fs_fsync: Dosyanın geri yazma tamponunu diske yazar.
+int fs_fsync(const char* filename) {
+    FsWriteLock lock;
+    if (!lock.locked())
+         return -1;
+    SuperBlock sb;
+    FileMetadata files[MAX_FILES];
+    if (load_metadata(&sb, files) < 0)
+         return -1;
+    int index = find_file_index(filename, &sb, files);
+    if (index == -1) {
+         std::cerr << "fs_fsync: Dosya bulunamadi\n";
          return -1;
     }
-    if (lseek(fd, new_start, SEEK_SET) < 0) {
-         perror("fs_append: lseek hatasi");
-         close(fd);
-         delete[] temp;
+    if (write_back.count(index) == 0)
+         return 0;
+    if (flush_write_back(std::vector<int>(1, index)) < 0)
          return -1;
-    }
-    if (write(fd, temp, new_total_size) != new_total_size) {
-         perror("fs_append: yazma hatasi");
-         close(fd);
-         delete[] temp;
+    fs_log((std::string("Dosya tamponu diske yazildi: ") + filename).c_str());
+    return 0;
+}
+
+// fs_sync: Tüm geri yazma tamponlarını diske yazar.
+int fs_sync() {
+    FsWriteLock lock;
+    if (!lock.locked())
          return -1;
-    }
-    close(fd);
-    files[index].start = new_start;
-    files[index].size = new_total_size;
-    if (write_metadata(files, file_count) < 0) {
-         delete[] temp;
+    if (write_back.empty())
+         return 0;
+    if (flush_all_write_back() < 0)
          return -1;
-    }
-    delete[] temp;
-    fs_log((std::string("Veri eklendi: ") + filename).c_str());
+    fs_log("Tum tamponlar diske yazildi");
     return 0;
 }
 
 // fs_truncate: Dosyanın mevcut içeriğinin, belirtilen yeni boyuta kadar olan kısmını kalır.
 int fs_truncate(const char* filename, int new_size) {
+    FsWriteLock lock;
+    if (!lock.locked())
+         return -1;
+    if (flush_all_write_back() < 0)
+         return -1;
+    SuperBlock sb;
     FileMetadata files[MAX_FILES];
-    int file_count;
-    if (load_metadata(files, &file_count) < 0)
+    if (load_metadata(&sb, files) < 0)
          return -1;
-    int index = find_file_index(filename, files, file_count);
+    int index = find_file_index(filename, &sb, files);
     if (index == -1) {
          std::cerr << "fs_truncate: Dosya bulunamadi\n";
          return -1;
@@ -401,44 +1627,45 @@ int fs_truncate(const char* filename, int new_size) {
              return -1;
          }
     }
-    uint32_t new_start = get_new_file_start(files, file_count, new_size);
+    uint32_t new_start = get_new_file_start(&sb, files, new_size);
     if (new_start == 0) {
          std::cerr << "fs_truncate: Yeterli alan yok\n";
          delete[] temp;
          return -1;
     }
-    int fd = open(DISK_FILENAME, O_RDWR);
+    std::unique_lock<std::shared_mutex> extents(extent_mutex);
+    int fd = disk_open(O_RDWR);
     if (fd < 0) {
          perror("fs_truncate: disk.sim acilamadi");
          delete[] temp;
          return -1;
     }
-    if (lseek(fd, new_start, SEEK_SET) < 0) {
-         perror("fs_truncate: lseek hatasi");
-         close(fd);
-         delete[] temp;
-         return -1;
-    }
-    if (write(fd, temp, new_size) != new_size) {
+    if (!disk_pwrite(fd, temp, new_size, new_start)) {
          perror("fs_truncate: yazma hatasi");
-         close(fd);
+         disk_close(fd);
          delete[] temp;
          return -1;
     }
-    close(fd);
+    disk_close(fd);
+    uint32_t old_start = files[index].start, old_size = files[index].size;
     files[index].start = new_start;
     files[index].size = new_size;
-    if (write_metadata(files, file_count) < 0) {
+    files[index].content_hash_valid = 0;
+    if (write_metadata(&sb, files) < 0) {
          delete[] temp;
          return -1;
     }
     delete[] temp;
+    release_file_extent(&sb, old_start, old_size);
     fs_log((std::string("Dosya kirpildi: ") + filename).c_str());
     return 0;
 }
 
 // fs_copy: Kaynak dosyanın içeriğini, hedef dosyaya kopyalar.
 int fs_copy(const char* src_filename, const char* dest_filename) {
+    FsWriteLock lock;
+    if (!lock.locked())
+         return -1;
     int src_size = fs_size(src_filename);
     if (src_size < 0) {
          std::cerr << "fs_copy: Kaynak dosya bulunamadi\n";
@@ -464,98 +1691,372 @@ int fs_copy(const char* src_filename, const char* dest_filename) {
     return 0;
 }
 
-// fs_mv: Dosyayı başka bir isimle taşır; burada basitçe yeniden adlandırma yapılır.
+// fs_copy_many: Birden çok dosyayı tek metadata güncellemesiyle kopyalar. Hedefler sırayla
+// yer ayrıldıktan sonra veri, iş çalan havuzda dosya başına/parça başına paralel kopyalanır.
+// Kopyalanan dosya sayısını döner; herhangi bir çift geçersizse hiçbir şey kopyalanmaz.
+int fs_copy_many(const char* const src_filenames[], const char* const dest_filenames[], int count) {
+    bool valid = count > 0 && src_filenames != NULL && dest_filenames != NULL;
+    for (int i = 0; valid && i < count; i++)
+         valid = src_filenames[i] != NULL && dest_filenames[i] != NULL;
+    if (!valid) {
+         std::cerr << "fs_copy_many: Gecersiz arguman\n";
+         return -1;
+    }
+    FsWriteLock lock;
+    if (!lock.locked())
+         return -1;
+    if (flush_all_write_back() < 0)
+         return -1;
+    SuperBlock sb;
+    FileMetadata files[MAX_FILES];
+    if (load_metadata(&sb, files) < 0)
+         return -1;
+    // Önce tüm çiftler doğrulanır ve slotlar ile alan ayrılır; geçersiz bir çift varsa
+    // hiçbir girdi bağlanmaz.
+    std::vector<int> sources(count), dests(count), parents(count);
+    std::vector<std::string> leaves(count);
+    uint32_t total = 0;
+    int next_slot = 0;
+    for (int i = 0; i < count; i++) {
+         sources[i] = find_file_index(src_filenames[i], &sb, files);
+         if (sources[i] == -1) {
+             std::cerr << "fs_copy_many: Kaynak dosya bulunamadi: " << src_filenames[i] << "\n";
+             return -1;
+         }
+         if (lookup_path(dest_filenames[i], &sb, files) != -1) {
+             std::cerr << "fs_copy_many: Hedef dosya zaten mevcut: " << dest_filenames[i] << "\n";
+             return -1;
+         }
+         parents[i] = resolve_parent(dest_filenames[i], &sb, files, leaves[i]);
+         while (next_slot < MAX_FILES && files[next_slot].valid)
+             next_slot++;
+         if (parents[i] == -1 || next_slot == MAX_FILES) {
+             std::cerr << "fs_copy_many: Hedef dosya olusturulamadi: " << dest_filenames[i] << "\n";
+             return -1;
+         }
+         for (int j = 0; j < i; j++) {
+             if (parents[j] == parents[i] && leaves[j] == leaves[i]) {
+                 std::cerr << "fs_copy_many: Hedef birden fazla verildi: " << dest_filenames[i] << "\n";
+                 return -1;
+             }
+         }
+         dests[i] = next_slot++;
+         total += files[sources[i]].size;
+    }
+    uint32_t new_start = get_new_file_start(&sb, files, total);
+    if (new_start == 0) {
+         std::cerr << "fs_copy_many: Yeterli alan yok\n";
+         return -1;
+    }
+    for (int i = 0; i < count; i++) {
+         int index = dests[i];
+         uint32_t size = files[sources[i]].size;
+         link_entry(&sb, files, index, parents[i], leaves[i], FS_TYPE_FILE);
+         files[index].start = new_start;
+         files[index].size = size;
+         // Kopya aynı içeriğe sahiptir; kaynağın özeti de geçerlidir.
+         files[index].content_hash_valid = files[sources[i]].content_hash_valid;
+         memcpy(files[index].content_hash, files[sources[i]].content_hash, HASH_SIZE);
+         new_start += size;
+    }
+    std::unique_lock<std::shared_mutex> extents(extent_mutex);
+    int fd = disk_open(O_RDWR);
+    if (fd < 0) {
+         perror("fs_copy_many: disk.sim acilamadi");
+         return -1;
+    }
+    std::vector<std::function<void()>> tasks;
+    std::atomic<bool> failed(false);
+    for (int i = 0; i < count; i++)
+         add_copy_tasks(tasks, failed, fd, files[sources[i]].start, fd, files[dests[i]].start, files[dests[i]].size);
+    fs_parallel_run(tasks);
+    disk_close(fd);
+    if (failed) {
+         perror("fs_copy_many: kopyalama hatasi");
+         return -1;
+    }
+    if (write_metadata(&sb, files) < 0)
+         return -1;
+    fs_log((std::string("Toplu kopyalama yapildi: ") + std::to_string(count) + " dosya").c_str());
+    return count;
+}
+
+// fs_mv: Dosyayı veya dizini başka bir dizine/isme taşır. Yalnızca metadata güncellenir,
+// veri blokları yerinde kalır. Hedef mevcut bir dizinse girdi aynı isimle onun içine taşınır.
 int fs_mv(const char* old_path, const char* new_path) {
-    return fs_rename(old_path, new_path);
+    FsWriteLock lock;
+    if (!lock.locked())
+         return -1;
+    if (move_entry("fs_mv", old_path, new_path, true) < 0)
+         return -1;
+    fs_log((std::string("Dosya tasindi: ") + old_path + " -> " + new_path).c_str());
+    return 0;
 }
 
-// fs_defragment: Disk üzerindeki parçalı veri bloklarını düzenler; tüm valid dosyaların verisini sıralı olarak yeni alana yazar.
-int fs_defragment() {
+// fs_mkdir: Yeni bir dizin oluşturur.
+int fs_mkdir(const char* path) {
+    FsWriteLock lock;
+    if (!lock.locked())
+         return -1;
+    SuperBlock sb;
+    FileMetadata files[MAX_FILES];
+    if (load_metadata(&sb, files) < 0)
+         return -1;
+    if (lookup_path(path, &sb, files) != -1) {
+         std::cerr << "fs_mkdir: Ayni isimde girdi zaten mevcut\n";
+         return -1;
+    }
+    std::string leaf;
+    int parent = resolve_parent(path, &sb, files, leaf);
+    if (parent == -1) {
+         std::cerr << "fs_mkdir: Ust dizin bulunamadi veya gecersiz isim\n";
+         return -1;
+    }
+    int index = find_free_slot(files);
+    if (index == -1) {
+         std::cerr << "fs_mkdir: Bos metadata slotu yok\n";
+         return -1;
+    }
+    link_entry(&sb, files, index, parent, leaf, FS_TYPE_DIR);
+    if (write_metadata(&sb, files) < 0)
+         return -1;
+    fs_log((std::string("Dizin olusturuldu: ") + path).c_str());
+    return 0;
+}
+
+// fs_rmdir: Boş bir dizini siler.
+int fs_rmdir(const char* path) {
+    FsWriteLock lock;
+    if (!lock.locked())
+         return -1;
+    SuperBlock sb;
+    FileMetadata files[MAX_FILES];
+    if (load_metadata(&sb, files) < 0)
+         return -1;
+    int index = lookup_path(path, &sb, files);
+    if (index < 0 || files[index].type != FS_TYPE_DIR) {
+         std::cerr << "fs_rmdir: Dizin bulunamadi\n";
+         return -1;
+    }
+    if (!dir_is_empty(files, index)) {
+         std::cerr << "fs_rmdir: Dizin bos degil\n";
+         return -1;
+    }
+    unlink_entry(&sb, files, index);
+    if (write_metadata(&sb, files) < 0)
+         return -1;
+    fs_log((std::string("Dizin silindi: ") + path).c_str());
+    return 0;
+}
+
+// fs_readdir: Dizindeki girdileri entries dizisine yazar, girdi sayısını döner.
+// Dizinde max_entries'ten fazla girdi varsa yalnızca ilk max_entries tanesi yazılır.
+int fs_readdir(const char* path, FsDirEntry* entries, int max_entries) {
+    std::lock_guard<std::recursive_mutex> lock(fs_mutex);
+    SuperBlock sb;
     FileMetadata files[MAX_FILES];
-    int file_count;
-    if (load_metadata(files, &file_count) < 0)
+    if (load_metadata(&sb, files) < 0)
+         return -1;
+    int dir = lookup_path(path, &sb, files);
+    if (dir == -1 || (dir != FS_ROOT && files[dir].type != FS_TYPE_DIR)) {
+         std::cerr << "fs_readdir: Dizin bulunamadi\n";
          return -1;
-    std::vector<FileMetadata> valid_files;
+    }
+    int count = 0;
+    for (int i = 0; i < MAX_FILES && count < max_entries; i++) {
+        if (files[i].valid && files[i].parent == dir) {
+            memcpy(entries[count].name, files[i].name, sizeof(entries[count].name));
+            entries[count].type = files[i].type;
+            entries[count].size = files[i].type == FS_TYPE_FILE ? effective_size(files, i) : files[i].size;
+            count++;
+        }
+    }
+    return count;
+}
+
+// Taşınan veri aralıklarını tablodaki dosyalara uygular
+static void remap_extents(FileMetadata files[], const std::map<uint32_t, uint32_t>& new_starts) {
     for (int i = 0; i < MAX_FILES; i++) {
-        if (files[i].valid)
-            valid_files.push_back(files[i]);
+        if (!files[i].valid || files[i].type != FS_TYPE_FILE)
+            continue;
+        if (files[i].size == 0)
+            files[i].start = METADATA_SIZE;  // Boş dosyaların verisi yoktur.
+        else
+            files[i].start = new_starts.at((uint32_t)files[i].start);
     }
-    std::sort(valid_files.begin(), valid_files.end(), [](const FileMetadata &a, const FileMetadata &b) {
-         return a.start < b.start;
-    });
-    int fd = open(DISK_FILENAME, O_RDWR);
+}
+
+// fs_defragment: Disk üzerindeki parçalı veri bloklarını düzenler; tüm valid dosyaların verisini sıralı olarak yeni alana yazar.
+// Snapshot'ların paylaştığı veri aralıkları bir kez taşınır ve tüm tablolar yeni konuma yönlendirilir.
+int fs_defragment() {
+    FsWriteLock lock;
+    if (!lock.locked())
+         return -1;
+    if (flush_all_write_back() < 0)
+         return -1;
+    std::unique_lock<std::shared_mutex> extents(extent_mutex);
+    SuperBlock sb;
+    FileMetadata files[MAX_FILES];
+    if (load_metadata(&sb, files) < 0)
+         return -1;
+    std::vector<int> slots;
+    std::vector<SnapshotTable> tables;
+    if (load_snapshot_tables(&sb, slots, tables) < 0)
+         return -1;
+    // Dizinlerin veri alanı yoktur; yalnızca dosya verisi aralıkları başlangıca göre sıralanır.
+    std::map<uint32_t, uint32_t> units;
+    collect_extents(files, units);
+    for (size_t t = 0; t < tables.size(); t++)
+         collect_extents(tables[t].files, units);
+    // Taşınacak aralıkların yeni konumları sırayla belirlenir.
+    std::map<uint32_t, uint32_t> new_starts;
+    std::vector<uint32_t> sources, targets, sizes;
+    uint32_t current_offset = METADATA_SIZE;
+    for (auto it = units.begin(); it != units.end(); ++it) {
+         new_starts[it->first] = current_offset;
+         if (it->first != current_offset) {
+             sources.push_back(it->first);
+             targets.push_back(current_offset);
+             sizes.push_back(it->second);
+         }
+         current_offset += it->second;
+    }
+    int fd = disk_open(O_RDWR);
     if (fd < 0) {
          perror("fs_defragment: disk.sim acilamadi");
          return -1;
     }
-    uint32_t current_offset = METADATA_SIZE;
-    for (size_t i = 0; i < valid_files.size(); i++) {
-         if (valid_files[i].start != current_offset) {
-             char* buffer = new char[valid_files[i].size];
-             if (lseek(fd, valid_files[i].start, SEEK_SET) < 0) {
-                 perror("fs_defragment: lseek hatasi");
-                 delete[] buffer;
-                 close(fd);
-                 return -1;
-             }
-             if (read(fd, buffer, valid_files[i].size) != (ssize_t)valid_files[i].size) {
-                 perror("fs_defragment: okuma hatasi");
-                 delete[] buffer;
-                 close(fd);
-                 return -1;
-             }
-             if (lseek(fd, current_offset, SEEK_SET) < 0) {
-                 perror("fs_defragment: lseek hatasi");
-                 delete[] buffer;
-                 close(fd);
-                 return -1;
-             }
-             if (write(fd, buffer, valid_files[i].size) != (ssize_t)valid_files[i].size) {
-                 perror("fs_defragment: yazma hatasi");
-                 delete[] buffer;
-                 close(fd);
-                 return -1;
-             }
-             // Metadata güncellemesi: Aynı isme sahip dosyayı bulup yeni start değerini ata.
-             for (int j = 0; j < MAX_FILES; j++) {
-                 if (files[j].valid && strcmp(files[j].name, valid_files[i].name) == 0) {
-                      files[j].start = current_offset;
-                      break;
-                 }
-             }
-             delete[] buffer;
-         }
-         current_offset += valid_files[i].size;
+    // Kaynak ve hedef aralıkları çakışabildiği için önce tüm taşınan aralıklar paralel
+    // okunur, ardından (birbiriyle çakışmayan) hedeflere paralel yazılır.
+    std::vector<std::vector<char>> buffers(sources.size());
+    std::atomic<bool> failed(false);
+    std::vector<std::function<void()>> tasks;
+    for (size_t i = 0; i < sources.size(); i++) {
+         tasks.push_back([&, i]() {
+             buffers[i].resize(sizes[i]);
+             if (!disk_pread(fd, buffers[i].data(), sizes[i], sources[i]))
+                 failed = true;
+         });
+    }
+    fs_parallel_run(tasks);
+    if (failed) {
+         perror("fs_defragment: okuma hatasi");
+         disk_close(fd);
+         return -1;
+    }
+    tasks.clear();
+    for (size_t i = 0; i < sources.size(); i++) {
+         tasks.push_back([&, i]() {
+             if (!disk_pwrite(fd, buffers[i].data(), sizes[i], targets[i]))
+                 failed = true;
+         });
+    }
+    fs_parallel_run(tasks);
+    disk_close(fd);
+    if (failed) {
+         perror("fs_defragment: yazma hatasi");
+         return -1;
+    }
+    remap_extents(files, new_starts);
+    for (size_t t = 0; t < tables.size(); t++) {
+         remap_extents(tables[t].files, new_starts);
+         if (write_snapshot_table(slots[t], &tables[t]) < 0)
+             return -1;
     }
-    close(fd);
-    if (write_metadata(files, file_count) < 0)
+    sb.snapshot_end = snapshot_data_end(tables);
+    if (write_metadata(&sb, files) < 0)
          return -1;
+    // Sıkıştırma sonrası son veri aralığından sonraki alanın tamamı boştur.
+    release_extent(current_offset, disk_capacity() - current_offset);
     fs_log("Disk defragmente edildi");
     return 0;
 }
 
 // fs_check_integrity: Metadata ve veri bloklarının tutarlılığını kontrol eder.
 int fs_check_integrity() {
+    std::lock_guard<std::recursive_mutex> lock(fs_mutex);
+    SuperBlock sb;
     FileMetadata files[MAX_FILES];
-    int file_count;
-    if (load_metadata(files, &file_count) < 0)
+    if (load_metadata(&sb, files) < 0)
          return -1;
     bool integrityOk = true;
     for (int i = 0; i < MAX_FILES; i++) {
-         if (files[i].valid) {
-             if (files[i].start < METADATA_SIZE || files[i].start + files[i].size > DISK_SIZE) {
-                 std::cerr << "fs_check_integrity: " << files[i].name << " dosyasinda tutarsizlik bulundu\n";
-                 integrityOk = false;
-             }
+         if (!files[i].valid)
+             continue;
+         if (files[i].type == FS_TYPE_FILE &&
+             (files[i].start < METADATA_SIZE || files[i].start + files[i].size > disk_capacity())) {
+             std::cerr << "fs_check_integrity: " << entry_path(files, i) << " dosyasinda tutarsizlik bulundu\n";
+             integrityOk = false;
+         }
+         // Üst dizin geçerli bir dizin olmalı ve girdi hash tablosundan bulunabilmeli.
+         int16_t parent = files[i].parent;
+         if ((parent != FS_ROOT && (parent < 0 || parent >= MAX_FILES || !files[parent].valid ||
+                                    files[parent].type != FS_TYPE_DIR)) ||
+             dir_lookup(sb.dir_hash, files, parent, files[i].name) != i) {
+             std::cerr << "fs_check_integrity: " << files[i].name << " dizin kaydinda tutarsizlik bulundu\n";
+             integrityOk = false;
          }
     }
     fs_log("Integrity kontrolu yapildi");
     return integrityOk ? 0 : -1;
 }
 
-// fs_backup: Tüm disk dosyasının yedeğini alır.
+// fs_scrub: Tüm dosyaların veri alanını paralel okuyarak doğrular.
+// Okunamayan dosya sayısını döner (0: sorun yok).
+int fs_scrub() {
+    std::unique_lock<std::recursive_mutex> lock(fs_mutex);
+    SuperBlock sb;
+    FileMetadata files[MAX_FILES];
+    if (load_metadata(&sb, files) < 0)
+         return -1;
+    std::shared_lock<std::shared_mutex> extents(extent_mutex);
+    lock.unlock();
+    int fd = disk_open(O_RDONLY);
+    if (fd < 0) {
+         perror("fs_scrub: disk.sim acilamadi");
+         return -1;
+    }
+    std::vector<std::atomic<bool>> bad(MAX_FILES);
+    std::vector<std::function<void()>> tasks;
+    for (int i = 0; i < MAX_FILES; i++) {
+         bad[i] = false;
+         if (!files[i].valid || files[i].type != FS_TYPE_FILE)
+             continue;
+         if (files[i].start < METADATA_SIZE || files[i].start + files[i].size > disk_capacity()) {
+             bad[i] = true;
+             continue;
+         }
+         for (size_t done = 0; done < files[i].size; done += PARALLEL_CHUNK) {
+             size_t chunk = std::min(PARALLEL_CHUNK, files[i].size - done);
+             off_t offset = files[i].start + done;
+             tasks.push_back([&bad, fd, i, offset, chunk]() {
+                 std::vector<char> buffer(chunk);
+                 if (!disk_pread(fd, buffer.data(), chunk, offset))
+                     bad[i] = true;
+             });
+         }
+    }
+    fs_parallel_run(tasks);
+    disk_close(fd);
+    int bad_count = 0;
+    for (int i = 0; i < MAX_FILES; i++) {
+         if (bad[i]) {
+             std::cerr << "fs_scrub: " << entry_path(files, i) << " dosyasi okunamadi\n";
+             bad_count++;
+         }
+    }
+    fs_log("Scrub yapildi");
+    return bad_count;
+}
+
+// fs_backup: Tüm disk dosyasının yedeğini, iş çalan havuzda paralel parçalar halinde alır.
 int fs_backup(const char* backup_filename) {
-    int src_fd = open(DISK_FILENAME, O_RDONLY);
+    FsWriteLock lock;
+    if (!lock.locked())
+         return -1;
+    if (flush_all_write_back() < 0)
+         return -1;
+    int src_fd = disk_open(O_RDONLY);
     if (src_fd < 0) {
          perror("fs_backup: disk.sim acilamadi");
          return -1;
@@ -563,56 +2064,363 @@ int fs_backup(const char* backup_filename) {
     int dest_fd = open(backup_filename, O_WRONLY | O_CREAT | O_TRUNC, 0666);
     if (dest_fd < 0) {
          perror("fs_backup: backup dosyasi acilamadi");
-         close(src_fd);
+         disk_close(src_fd);
          return -1;
     }
-    char buffer[1024];
-    ssize_t bytes;
-    while ((bytes = read(src_fd, buffer, sizeof(buffer))) > 0) {
-         if (write(dest_fd, buffer, bytes) != bytes) {
-             perror("fs_backup: yazma hatasi");
-             close(src_fd);
-             close(dest_fd);
-             return -1;
-         }
+    if (parallel_copy_file("fs_backup", src_fd, dest_fd) < 0) {
+         disk_close(src_fd);
+         close(dest_fd);
+         return -1;
     }
-    close(src_fd);
+    disk_close(src_fd);
     close(dest_fd);
     fs_log((std::string("Disk yedegi alindi: ") + backup_filename).c_str());
     return 0;
 }
 
-// fs_restore: Yedek dosyasını, mevcut disk.sim dosyasının yerine geri yükler.
+// fs_restore: Yedek dosyasını, mevcut disk.sim dosyasının yerine paralel parçalar halinde geri yükler.
 int fs_restore(const char* backup_filename) {
+    FsWriteLock lock;
+    if (!lock.locked())
+         return -1;
+    std::unique_lock<std::shared_mutex> extents(extent_mutex);
     int src_fd = open(backup_filename, O_RDONLY);
     if (src_fd < 0) {
          perror("fs_restore: backup dosyasi acilamadı");
          return -1;
     }
-    int dest_fd = open(DISK_FILENAME, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    // Yedek mantıksal imajdır; yalnızca aynı düzendeki (imaj sayısı ve şerit boyu) bir birime yüklenebilir.
+    SuperBlock backup_sb;
+    if (disk_size(src_fd) < METADATA_SIZE ||
+        !disk_pread(src_fd, (char*)&backup_sb, sizeof(backup_sb), 0) ||
+        backup_sb.magic != FS_MAGIC || backup_sb.version != FS_VERSION) {
+         std::cerr << "fs_restore: Yedek dosyasi gecersiz veya surum uyumsuz\n";
+         close(src_fd);
+         return -1;
+    }
+    if (backup_sb.member_count != disk_member_count() || backup_sb.stripe_unit != disk_stripe_unit()) {
+         std::cerr << "fs_restore: Yedek farkli bir birim duzenine ait\n";
+         close(src_fd);
+         return -1;
+    }
+    discard_all_write_back();  // Bekleyen veri, yerine gelecek imajın dosyalarına ait değildir.
+    // Paylaşımlı modda metadata alanı diğer süreçlerde eşli olduğundan kesilmez; eşleme
+    // üzerinden sıfırlanır ve kopyalama boyunca okuyucular sayaç tek olduğu için bekler.
+    SharedWriteSection section;
+    int dest_fd = disk_open(shared_metadata != NULL ? O_WRONLY : O_WRONLY | O_CREAT | O_TRUNC, 0666);
     if (dest_fd < 0) {
          perror("fs_restore: disk.sim acilamadi");
          close(src_fd);
          return -1;
     }
-    char buffer[1024];
-    ssize_t bytes;
-    while ((bytes = read(src_fd, buffer, sizeof(buffer))) > 0) {
-         if (write(dest_fd, buffer, bytes) != bytes) {
-             perror("fs_restore: yazma hatasi");
+    if (shared_metadata != NULL) {
+         if (disk_truncate(dest_fd, METADATA_SIZE) < 0) {
+             perror("fs_restore: disk.sim kesilemedi");
              close(src_fd);
-             close(dest_fd);
+             disk_close(dest_fd);
              return -1;
          }
+         memset(shared_metadata, 0, METADATA_SIZE);
+    }
+    if (parallel_copy_file("fs_restore", src_fd, dest_fd) < 0 ||
+        disk_write_labels(dest_fd, backup_sb.volume_id) < 0) {
+         close(src_fd);
+         disk_close(dest_fd);
+         return -1;
     }
     close(src_fd);
-    close(dest_fd);
+    disk_close(dest_fd);
+    dentry_invalidate();
+    name_index_valid = false;
+    if (shared_metadata != NULL) {
+         // Diğer süreçlerin isim cache'leri yedekteki generation'ı tanıyor olabilir.
+         SuperBlock sb;
+         FileMetadata files[MAX_FILES];
+         if (load_metadata(&sb, files) < 0)
+             return -1;
+         sb.generation++;
+         if (write_metadata(&sb, files) < 0)
+             return -1;
+    }
     fs_log((std::string("Disk yedegi geri yuklendi: ") + backup_filename).c_str());
     return 0;
 }
 
+// fs_snapshot_create: Canlı isim alanının dondurulmuş bir kopyasını oluşturur. Yalnızca
+// metadata tablosu kopyalanır; veri blokları canlı dosyalarla paylaşılır ve bundan sonra
+// değişen dosyalar yeni konuma yazıldığı için snapshot'ın verisi korunur.
+int fs_snapshot_create(const char* name) {
+    FsWriteLock lock;
+    if (!lock.locked())
+         return -1;
+    if (flush_all_write_back() < 0)
+         return -1;
+    SuperBlock sb;
+    FileMetadata files[MAX_FILES];
+    if (load_metadata(&sb, files) < 0)
+         return -1;
+    if (name[0] == '\0' || strlen(name) >= (size_t)MAX_SNAPSHOT_NAME) {
+         std::cerr << "fs_snapshot_create: Gecersiz snapshot ismi\n";
+         return -1;
+    }
+    if (find_snapshot(&sb, name) != -1) {
+         std::cerr << "fs_snapshot_create: Snapshot zaten mevcut\n";
+         return -1;
+    }
+    int slot = -1;
+    for (int i = 0; i < MAX_SNAPSHOTS && slot == -1; i++) {
+         if (!sb.snapshots[i].valid)
+             slot = i;
+    }
+    if (slot == -1) {
+         std::cerr << "fs_snapshot_create: Bos snapshot slotu yok\n";
+         return -1;
+    }
+    SnapshotTable table;
+    table.file_count = sb.file_count;
+    memcpy(table.dir_hash, sb.dir_hash, sizeof(table.dir_hash));
+    memcpy(table.files, files, sizeof(table.files));
+    if (write_snapshot_table(slot, &table) < 0)
+         return -1;
+    SnapshotInfo& info = sb.snapshots[slot];
+    memset(&info, 0, sizeof(info));
+    info.valid = 1;
+    strncpy(info.name, name, sizeof(info.name) - 1);
+    info.creationTime = time(NULL);
+    // Canlı verinin sonu artık snapshot'a aittir; yeni yazmalar bunun ötesine yapılır.
+    sb.snapshot_end = get_new_file_start(&sb, files, 0);
+    if (write_metadata(&sb, files) < 0)
+         return -1;
+    fs_log((std::string("Snapshot olusturuldu: ") + name).c_str());
+    return 0;
+}
+
+// fs_snapshot_list: Snapshot bilgilerini infos dizisine yazar, snapshot sayısını döner.
+int fs_snapshot_list(FsSnapshotInfo* infos, int max_infos) {
+    std::lock_guard<std::recursive_mutex> lock(fs_mutex);
+    SuperBlock sb;
+    FileMetadata files[MAX_FILES];
+    if (load_metadata(&sb, files) < 0)
+         return -1;
+    std::vector<int> slots;
+    std::vector<SnapshotTable> tables;
+    if (load_snapshot_tables(&sb, slots, tables) < 0)
+         return -1;
+    int count = 0;
+    for (size_t t = 0; t < tables.size() && count < max_infos; t++) {
+         // Yalnızca bu snapshot'ın başvurduğu veri, snapshot'ın gerçek alan maliyetidir.
+         std::map<uint32_t, uint32_t> own, shared;
+         collect_extents(tables[t].files, own);
+         collect_extents(files, shared);
+         for (size_t u = 0; u < tables.size(); u++) {
+             if (u != t)
+                 collect_extents(tables[u].files, shared);
+         }
+         uint32_t exclusive = 0;
+         for (auto it = own.begin(); it != own.end(); ++it) {
+             if (shared.find(it->first) == shared.end())
+                 exclusive += it->second;
+         }
+         const SnapshotInfo& info = sb.snapshots[slots[t]];
+         memcpy(infos[count].name, info.name, sizeof(infos[count].name));
+         infos[count].creationTime = info.creationTime;
+         infos[count].file_count = tables[t].file_count;
+         infos[count].exclusive_bytes = exclusive;
+         count++;
+    }
+    return count;
+}
+
+// fs_snapshot_read: Dosyanın snapshot anındaki içeriğinden okuma yapar.
+int fs_snapshot_read(const char* snapshot, const char* filename, int offset, int size, char* buffer) {
+    std::unique_lock<std::recursive_mutex> lock(fs_mutex);
+    SuperBlock sb;
+    FileMetadata files[MAX_FILES];
+    if (load_metadata(&sb, files) < 0)
+         return -1;
+    int slot = find_snapshot(&sb, snapshot);
+    if (slot == -1) {
+         std::cerr << "fs_snapshot_read: Snapshot bulunamadi\n";
+         return -1;
+    }
+    SnapshotTable table;
+    if (read_snapshot_table(slot, &table) < 0)
+         return -1;
+    std::vector<std::string> parts;
+    int index = split_path(filename, parts) ? walk_path(parts, table.dir_hash, table.files) : -1;
+    if (index < 0 || table.files[index].type != FS_TYPE_FILE) {
+         std::cerr << "fs_snapshot_read: Dosya bulunamadi\n";
+         return -1;
+    }
+    if (offset + size > (int)table.files[index].size) {
+         std::cerr << "fs_snapshot_read: Okuma, dosya boyutunu asiyor\n";
+         return -1;
+    }
+    std::shared_lock<std::shared_mutex> extents(extent_mutex);
+    lock.unlock();
+    int fd = disk_open(O_RDONLY);
+    if (fd < 0) {
+         perror("fs_snapshot_read: disk.sim acilamadi");
+         return -1;
+    }
+    if (!disk_pread(fd, buffer, size, table.files[index].start + offset)) {
+         perror("fs_snapshot_read: okuma hatasi");
+         disk_close(fd);
+         return -1;
+    }
+    disk_close(fd);
+    return size;
+}
+
+// Verilen aralıklardan hiçbir tabloda başvurulmayanları host'a iade eder
+static void release_unreferenced(const std::map<uint32_t, uint32_t>& candidates,
+                                 const std::map<uint32_t, uint32_t>& referenced) {
+    for (auto it = candidates.begin(); it != candidates.end(); ++it) {
+        if (referenced.find(it->first) == referenced.end())
+            release_extent(it->first, it->second);
+    }
+}
+
+// fs_snapshot_rollback: Canlı isim alanını snapshot anına geri döndürür. Snapshot korunur;
+// yalnızca canlı tabloya ait olup artık hiçbir yerde kullanılmayan veri serbest bırakılır.
+int fs_snapshot_rollback(const char* name) {
+    FsWriteLock lock;
+    if (!lock.locked())
+         return -1;
+    std::unique_lock<std::shared_mutex> extents(extent_mutex);
+    SuperBlock sb;
+    FileMetadata files[MAX_FILES];
+    if (load_metadata(&sb, files) < 0)
+         return -1;
+    int slot = find_snapshot(&sb, name);
+    if (slot == -1) {
+         std::cerr << "fs_snapshot_rollback: Snapshot bulunamadi\n";
+         return -1;
+    }
+    std::vector<int> slots;
+    std::vector<SnapshotTable> tables;
+    if (load_snapshot_tables(&sb, slots, tables) < 0)
+         return -1;
+    std::map<uint32_t, uint32_t> old_live, referenced;
+    collect_extents(files, old_live);
+    for (size_t t = 0; t < tables.size(); t++) {
+         collect_extents(tables[t].files, referenced);
+         if (slots[t] == slot) {
+             sb.file_count = tables[t].file_count;
+             memcpy(sb.dir_hash, tables[t].dir_hash, sizeof(sb.dir_hash));
+             memcpy(files, tables[t].files, sizeof(tables[t].files));
+         }
+    }
+    bump_generation(&sb);
+    name_index_valid = false;
+    if (write_metadata(&sb, files) < 0)
+         return -1;
+    discard_all_write_back();  // Snapshot'tan sonraki değişiklikler geri alınır.
+    release_unreferenced(old_live, referenced);
+    fs_log((std::string("Snapshot'a geri donuldu: ") + name).c_str());
+    return 0;
+}
+
+// fs_snapshot_delete: Snapshot'ı siler ve yalnızca onun tuttuğu veriyi serbest bırakır.
+int fs_snapshot_delete(const char* name) {
+    FsWriteLock lock;
+    if (!lock.locked())
+         return -1;
+    std::unique_lock<std::shared_mutex> extents(extent_mutex);
+    SuperBlock sb;
+    FileMetadata files[MAX_FILES];
+    if (load_metadata(&sb, files) < 0)
+         return -1;
+    int slot = find_snapshot(&sb, name);
+    if (slot == -1) {
+         std::cerr << "fs_snapshot_delete: Snapshot bulunamadi\n";
+         return -1;
+    }
+    SnapshotTable deleted;
+    if (read_snapshot_table(slot, &deleted) < 0)
+         return -1;
+    sb.snapshots[slot].valid = 0;
+    std::vector<int> slots;
+    std::vector<SnapshotTable> tables;
+    if (load_snapshot_tables(&sb, slots, tables) < 0)
+         return -1;
+    sb.snapshot_end = snapshot_data_end(tables);
+    if (write_metadata(&sb, files) < 0)
+         return -1;
+    std::map<uint32_t, uint32_t> candidates, referenced;
+    collect_extents(deleted.files, candidates);
+    collect_extents(files, referenced);
+    for (size_t t = 0; t < tables.size(); t++)
+         collect_extents(tables[t].files, referenced);
+    release_unreferenced(candidates, referenced);
+    fs_log((std::string("Snapshot silindi: ") + name).c_str());
+    return 0;
+}
+
+// fs_set_direct_io: disk.sim erişimini O_DIRECT moduna alır veya tamponlu moda döndürür.
+// Direct modda host sayfa önbelleği atlanır; her aktarım disk hizalamasına (BLOCK_SIZE veya
+// cihazın mantıksal blok boyutu) göre havuzdan alınan hizalı tamponlar üzerinden yapılır.
+int fs_set_direct_io(int enabled) {
+    FsWriteLock lock;
+    if (!lock.locked())
+         return -1;
+    std::unique_lock<std::shared_mutex> extents(extent_mutex);
+    if (enabled && shared_metadata != NULL) {
+         std::cerr << "fs_set_direct_io: Paylasimli metadata modunda kullanilamaz\n";
+         return -1;
+    }
+    if (disk_set_direct(enabled != 0) < 0)
+         return -1;
+    fs_log(enabled ? "Direct I/O acildi" : "Direct I/O kapatildi");
+    return 0;
+}
+
+int fs_get_direct_io() {
+    return disk_direct() ? 1 : 0;
+}
+
+// fs_set_shared_metadata: Metadata alanını, aynı imajı kullanan süreçlerle paylaşılan bir
+// eşlemeye taşır veya süreç içi okumaya döndürür. Paylaşımlı modda okuyucular metadata'yı
+// kilitsiz (seqlock ile doğrulanan) bir kopyayla okur; değiştiren işlemler süreçler arası
+// yazıcı kilidiyle sıralanır ve geri yazma tamponu kullanılmaz. Aynı imajı kullanan tüm
+// süreçler bu modda olmalıdır. Metadata sayfa önbelleğinden okunduğu için direct I/O ile
+// birlikte kullanılamaz.
+int fs_set_shared_metadata(int enabled) {
+    FsWriteLock lock;
+    if (!lock.locked())
+         return -1;
+    if ((shared_metadata != NULL) == (enabled != 0))
+         return 0;
+    if (!enabled) {
+         // fs_read'ler mod kontrolünü veri alanı kilidi altında yapar.
+         std::unique_lock<std::shared_mutex> extents(extent_mutex);
+         unmap_shared();
+         fs_log("Paylasimli metadata kapatildi");
+         return 0;
+    }
+    if (disk_direct()) {
+         std::cerr << "fs_set_shared_metadata: Direct I/O acikken kullanilamaz\n";
+         return -1;
+    }
+    SuperBlock sb;
+    FileMetadata files[MAX_FILES];
+    if (flush_all_write_back() < 0 || load_metadata(&sb, files) < 0)
+         return -1;
+    std::unique_lock<std::shared_mutex> extents(extent_mutex);
+    if (map_shared() < 0)
+         return -1;
+    fs_log("Paylasimli metadata acildi");
+    return 0;
+}
+
+int fs_get_shared_metadata() {
+    std::lock_guard<std::recursive_mutex> lock(fs_mutex);
+    return shared_metadata != NULL ? 1 : 0;
+}
+
 // fs_cat: Dosyanın içeriğini ekrana yazdırır.
 int fs_cat(const char* filename) {
+    std::lock_guard<std::recursive_mutex> lock(fs_mutex);
     int size = fs_size(filename);
     if (size < 0)
          return -1;
@@ -628,31 +2436,152 @@ int fs_cat(const char* filename) {
     return 0;
 }
 
-// fs_diff: İki dosyanın içeriğini karşılaştırır.
-int fs_diff(const char* file1, const char* file2) {
-    int size1 = fs_size(file1);
-    int size2 = fs_size(file2);
-    if (size1 < 0 || size2 < 0)
-         return -1;
-    if (size1 != size2) {
-         std::cout << "Dosyalar farkli boyutta.\n";
-         fs_log("Dosyalar farkli (diff): boyutlar uyumsuz");
+// Karşılaştırmada bir seferde okunan parça boyutu
+const size_t DIFF_CHUNK = 1024 * 1024;
+
+// Farklı byte aralıklarını biriktirir; ardışık aralıklar birleştirilir.
+struct DiffRanges {
+    FsDiffRange* out;
+    int max;
+    int count;
+    uint32_t last_end;
+};
+
+static void add_diff_range(DiffRanges* ranges, uint32_t start, uint32_t end) {
+    if (start == end)
+        return;
+    if (ranges->count > 0 && ranges->last_end == start) {
+        ranges->last_end = end;
+        if (ranges->count <= ranges->max)
+            ranges->out[ranges->count - 1].end = end;
+        return;
+    }
+    ranges->count++;
+    ranges->last_end = end;
+    if (ranges->count <= ranges->max) {
+        ranges->out[ranges->count - 1].start = start;
+        ranges->out[ranges->count - 1].end = end;
+    }
+}
+
+// Dosyanın [offset, offset+size) aralığını (gerekirse) özetine ekler
+static bool hash_range(int fd, const FileMetadata& file, Sha256* ctx, uint32_t offset, uint32_t size, std::vector<char>& buffer) {
+    for (uint32_t done = 0; done < size; done += DIFF_CHUNK) {
+        size_t chunk = std::min((size_t)(size - done), DIFF_CHUNK);
+        if (!disk_pread(fd, buffer.data(), chunk, file.start + offset + done))
+            return false;
+        sha256_update(ctx, buffer.data(), chunk);
+    }
+    return true;
+}
+
+// fs_diff_ranges: İki dosyayı parça parça karşılaştırır ve farklı byte aralıklarını döner.
+// Toplam aralık sayısını döner (0: dosyalar aynı); ilk max_ranges aralık ranges'e yazılır.
+// Boyutlar farklıysa kısa dosyanın sonundan uzun dosyanın sonuna kadar olan kısım da bir
+// farklılıktır. İçerik özetleri metadata'da saklanır: iki dosyanın özeti de geçerli ve eşitse
+// veri okunmadan sonuç döner; eksik özetler karşılaştırma sırasında hesaplanıp kaydedilir.
+int fs_diff_ranges(const char* file1, const char* file2, FsDiffRange* ranges, int max_ranges) {
+    FsWriteLock lock;
+    if (!lock.locked())
+         return -1;
+    SuperBlock sb;
+    FileMetadata files[MAX_FILES];
+    if (load_metadata(&sb, files) < 0)
+         return -1;
+    int index1 = find_file_index(file1, &sb, files);
+    int index2 = find_file_index(file2, &sb, files);
+    if (index1 == -1 || index2 == -1) {
+         std::cerr << "fs_diff: Dosya bulunamadi\n";
+         return -1;
+    }
+    // Karşılaştırma diskteki içerik üzerinde yapılır; bekleyen yazmalar önce boşaltılır.
+    std::vector<int> pending;
+    if (write_back.count(index1))
+         pending.push_back(index1);
+    if (write_back.count(index2) && index2 != index1)
+         pending.push_back(index2);
+    if (!pending.empty() && (flush_write_back(pending) < 0 || load_metadata(&sb, files) < 0))
+         return -1;
+    FileMetadata& a = files[index1];
+    FileMetadata& b = files[index2];
+    if (a.size == b.size && a.content_hash_valid && b.content_hash_valid &&
+        memcmp(a.content_hash, b.content_hash, HASH_SIZE) == 0)
          return 0;
+    DiffRanges result = { ranges, max_ranges, 0, 0 };
+    bool hash_a = !a.content_hash_valid, hash_b = !b.content_hash_valid;
+    Sha256 ctx_a, ctx_b;
+    sha256_init(&ctx_a);
+    sha256_init(&ctx_b);
+    uint32_t common = std::min((uint32_t)a.size, (uint32_t)b.size);
+    std::vector<char> buffer_a(DIFF_CHUNK), buffer_b(DIFF_CHUNK);
+    std::shared_lock<std::shared_mutex> extents(extent_mutex);
+    int fd = disk_open(O_RDONLY);
+    if (fd < 0) {
+         perror("fs_diff: disk.sim acilamadi");
+         return -1;
+    }
+    bool ok = true;
+    for (uint32_t offset = 0; ok && offset < common; offset += DIFF_CHUNK) {
+         size_t chunk = std::min((size_t)(common - offset), DIFF_CHUNK);
+         ok = disk_pread(fd, buffer_a.data(), chunk, a.start + offset) &&
+              disk_pread(fd, buffer_b.data(), chunk, b.start + offset);
+         if (!ok)
+             break;
+         if (hash_a)
+             sha256_update(&ctx_a, buffer_a.data(), chunk);
+         if (hash_b)
+             sha256_update(&ctx_b, buffer_b.data(), chunk);
+         // Eşit bölgeler fs_mismatch ile, farklı bölgeler fs_match ile vektör hızında atlanır.
+         size_t pos = 0;
+         while (pos < chunk) {
+             pos += fs_mismatch(buffer_a.data() + pos, buffer_b.data() + pos, chunk - pos);
+             if (pos == chunk)
+                 break;
+             size_t start = pos;
+             pos += fs_match(buffer_a.data() + pos, buffer_b.data() + pos, chunk - pos);
+             add_diff_range(&result, offset + start, offset + pos);
+         }
     }
-    char* buffer1 = new char[size1];
-    char* buffer2 = new char[size2];
-    if (fs_read(file1, 0, size1, buffer1) < 0 || fs_read(file2, 0, size2, buffer2) < 0) {
-         delete[] buffer1;
-         delete[] buffer2;
+    add_diff_range(&result, common, std::max((uint32_t)a.size, (uint32_t)b.size));
+    if (ok && hash_a)
+         ok = hash_range(fd, a, &ctx_a, common, a.size - common, buffer_a);
+    if (ok && hash_b)
+         ok = hash_range(fd, b, &ctx_b, common, b.size - common, buffer_b);
+    disk_close(fd);
+    if (!ok) {
+         perror("fs_diff: okuma hatasi");
          return -1;
     }
-    bool identical = (memcmp(buffer1, buffer2, size1) == 0);
-    if (identical)
+    extents.unlock();
+    if (hash_a) {
+         sha256_final(&ctx_a, a.content_hash);
+         a.content_hash_valid = 1;
+    }
+    if (hash_b && index2 != index1) {
+         sha256_final(&ctx_b, b.content_hash);
+         b.content_hash_valid = 1;
+    }
+    if ((hash_a || hash_b) && write_metadata(&sb, files) < 0)
+         return -1;
+    return result.count;
+}
+
+// fs_diff: İki dosyanın içeriğini karşılaştırır ve farklı byte aralıklarını yazdırır.
+int fs_diff(const char* file1, const char* file2) {
+    const int MAX_SHOWN = 16;
+    FsDiffRange ranges[MAX_SHOWN];
+    int count = fs_diff_ranges(file1, file2, ranges, MAX_SHOWN);
+    if (count < 0)
+         return -1;
+    if (count == 0) {
          std::cout << "Dosyalar ayni.\n";
-    else
-         std::cout << "Dosyalar farkli.\n";
-    delete[] buffer1;
-    delete[] buffer2;
+    } else {
+         std::cout << "Dosyalar farkli (" << count << " aralik):\n";
+         for (int i = 0; i < count && i < MAX_SHOWN; i++)
+             std::cout << "  [" << ranges[i].start << ", " << ranges[i].end << ")\n";
+         if (count > MAX_SHOWN)
+             std::cout << "  ... " << (count - MAX_SHOWN) << " aralik daha\n";
+    }
     fs_log((std::string("Dosya karsilastirmasi (diff) yapildi: ") + file1 + " ve " + file2).c_str());
     return 0;
 }
@@ -2,12 +2,25 @@
 #include <cstring>
 #include "fs.h"
 
-int main() {
+// fs_list girdilerini ekrana yazdırır
+static int print_entry(const FsListEntry* entry, void* ctx) {
+    std::cout << entry->path << (entry->type == FS_TYPE_DIR ? "/" : "") << "\n";
+    return 0;
+}
+
+// Komut satırında imaj dosyaları verilirse (./simplefs a.img b.img ...) disk.sim yerine
+// bu imajlardan oluşan birim kullanılır.
+int main(int argc, char* argv[]) {
     int choice;
     char filename[100], filename2[100];
     char data[1024];
     int size, offset, new_size;
     char backup_name[100];
+    const char* const* images = argv + 1;
+    int image_count = argc - 1;
+
+    if (image_count > 0 && fs_mount(images, image_count) < 0)
+        std::cout << "Birim baglanamadi; formatlamak icin 32'yi secin.\n";
 
     while (true) {
         std::cout << "\n--- SimpleFS Menu ---\n";
@@ -31,6 +44,20 @@ int main() {
         std::cout << "18. Dosyayi goruntule (fs_cat)\n";
         std::cout << "19. Dosyalari karsilastir (fs_diff)\n";
         std::cout << "20. Cikis\n";
+        std::cout << "21. Dizin olustur (fs_mkdir)\n";
+        std::cout << "22. Dizin sil (fs_rmdir)\n";
+        std::cout << "23. Dizin icerigini listele (fs_readdir)\n";
+        std::cout << "24. Onek ile sayfali listele (fs_list)\n";
+        std::cout << "25. Veri alanini dogrula (fs_scrub)\n";
+        std::cout << "26. Snapshot olustur (fs_snapshot_create)\n";
+        std::cout << "27. Snapshotlari listele (fs_snapshot_list)\n";
+        std::cout << "28. Snapshottaki dosyayi goruntule (fs_snapshot_read)\n";
+        std::cout << "29. Snapshota geri don (fs_snapshot_rollback)\n";
+        std::cout << "30. Snapshot sil (fs_snapshot_delete)\n";
+        std::cout << "31. Direct I/O ac/kapat (fs_set_direct_io)\n";
+        std::cout << "32. Komut satirindaki imajlarla birim formatla (fs_format_volume)\n";
+        std::cout << "33. Tamponlari diske yaz (fs_sync)\n";
+        std::cout << "34. Paylasimli metadata ac/kapat (fs_set_shared_metadata)\n";
         std::cout << "Seciminiz: ";
         std::cin >> choice;
         
@@ -134,9 +161,9 @@ int main() {
                     std::cout << "Dosya kopyalandi.\n";
                 break;
             case 13:
-                std::cout << "Eski dosya adi: ";
+                std::cout << "Eski yol: ";
                 std::cin >> filename;
-                std::cout << "Yeni dosya adi: ";
+                std::cout << "Yeni yol veya hedef dizin: ";
                 std::cin >> filename2;
                 if (fs_mv(filename, filename2) == 0)
                     std::cout << "Dosya tasindi.\n";
@@ -177,7 +204,129 @@ int main() {
                 break;
             case 20:
                 std::cout << "Cikis yapiliyor...\n";
+                fs_sync();
                 return 0;
+            case 21:
+                std::cout << "Dizin yolu: ";
+                std::cin >> filename;
+                if (fs_mkdir(filename) == 0)
+                    std::cout << "Dizin olusturuldu.\n";
+                break;
+            case 22:
+                std::cout << "Silinecek dizin yolu: ";
+                std::cin >> filename;
+                if (fs_rmdir(filename) == 0)
+                    std::cout << "Dizin silindi.\n";
+                break;
+            case 23:
+                std::cout << "Dizin yolu: ";
+                std::cin >> filename;
+                {
+                    FsDirEntry entries[MAX_FILES];
+                    int count = fs_readdir(filename, entries, MAX_FILES);
+                    for (int i = 0; i < count; i++) {
+                        if (entries[i].type == FS_TYPE_DIR)
+                            std::cout << entries[i].name << "/\n";
+                        else
+                            std::cout << entries[i].name << " (" << entries[i].size << " bytes)\n";
+                    }
+                }
+                break;
+            case 24:
+                std::cout << "Yol oneki (tumu icin /): ";
+                std::cin >> filename;
+                std::cout << "Sayfa boyutu: ";
+                std::cin >> size;
+                {
+                    FsListOptions opts = {};
+                    opts.prefix = filename;
+                    opts.limit = size;
+                    char cursor[1024] = "";
+                    do {
+                        opts.cursor = cursor;
+                        char next[1024];
+                        if (fs_list(&opts, print_entry, NULL, next, sizeof(next)) < 0)
+                            break;
+                        strcpy(cursor, next);
+                        if (cursor[0] != '\0')
+                            std::cout << "-- devami var --\n";
+                    } while (cursor[0] != '\0');
+                }
+                break;
+            case 25:
+                {
+                    int bad = fs_scrub();
+                    if (bad == 0)
+                        std::cout << "Tum dosyalar okunabilir.\n";
+                    else if (bad > 0)
+                        std::cout << bad << " dosya okunamadi.\n";
+                }
+                break;
+            case 26:
+                std::cout << "Snapshot adi: ";
+                std::cin >> backup_name;
+                if (fs_snapshot_create(backup_name) == 0)
+                    std::cout << "Snapshot olusturuldu.\n";
+                break;
+            case 27:
+                {
+                    FsSnapshotInfo infos[MAX_SNAPSHOTS];
+                    int count = fs_snapshot_list(infos, MAX_SNAPSHOTS);
+                    for (int i = 0; i < count; i++)
+                        std::cout << infos[i].name << ": " << infos[i].file_count << " girdi, "
+                                  << infos[i].exclusive_bytes << " bytes ayrik veri\n";
+                }
+                break;
+            case 28:
+                std::cout << "Snapshot adi: ";
+                std::cin >> backup_name;
+                std::cout << "Dosya adi: ";
+                std::cin >> filename;
+                std::cout << "Okunacak boyut: ";
+                std::cin >> size;
+                {
+                    char buffer[1024];
+                    int ret = size < (int)sizeof(buffer) ? fs_snapshot_read(backup_name, filename, 0, size, buffer) : -1;
+                    if (ret > 0) {
+                        buffer[ret] = '\0';
+                        std::cout << "Okunan veri: " << buffer << "\n";
+                    }
+                }
+                break;
+            case 29:
+                std::cout << "Snapshot adi: ";
+                std::cin >> backup_name;
+                if (fs_snapshot_rollback(backup_name) == 0)
+                    std::cout << "Snapshota geri donuldu.\n";
+                break;
+            case 30:
+                std::cout << "Snapshot adi: ";
+                std::cin >> backup_name;
+                if (fs_snapshot_delete(backup_name) == 0)
+                    std::cout << "Snapshot silindi.\n";
+                break;
+            case 31:
+                if (fs_set_direct_io(!fs_get_direct_io()) == 0)
+                    std::cout << (fs_get_direct_io() ? "Direct I/O acik.\n" : "Direct I/O kapali.\n");
+                break;
+            case 32:
+                if (image_count == 0) {
+                    std::cout << "Imaj verilmedi; ./simplefs imaj1 imaj2 ... ile baslatin.\n";
+                    break;
+                }
+                std::cout << "Serit boyutu (KB, 0: varsayilan): ";
+                std::cin >> size;
+                if (fs_format_volume(images, image_count, size * 1024) == 0)
+                    std::cout << "Birim formatlandi.\n";
+                break;
+            case 33:
+                if (fs_sync() == 0)
+                    std::cout << "Tamponlar diske yazildi.\n";
+                break;
+            case 34:
+                if (fs_set_shared_metadata(!fs_get_shared_metadata()) == 0)
+                    std::cout << (fs_get_shared_metadata() ? "Paylasimli metadata acik.\n" : "Paylasimli metadata kapali.\n");
+                break;
             default:
                 std::cout << "Gecersiz secim, lutfen tekrar deneyin.\n";
                 break;
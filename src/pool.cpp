@@ -0,0 +1,180 @@
+#include "fs.h"
+#include "fs_internal.h"
+#include <atomic>
+#include <cstdlib>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+// İş çalan (work-stealing) havuz: her işçinin kendi kuyruğu vardır. İşçi önce kendi
+// kuyruğunun sonundan alır, boşsa diğer kuyrukların başından çalar. fs_parallel_run'ı
+// çağıran iş parçacığı da bekleme yerine görev çalarak işe katılır; böylece havuz
+// görevleri içinden yeniden fs_parallel_run çağrılabilir.
+
+struct TaskGroup {
+    std::atomic<int> remaining;
+    std::mutex mutex;
+    std::condition_variable done;
+};
+
+struct PoolTask {
+    const std::function<void()>* fn;
+    TaskGroup* group;
+};
+
+struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<PoolTask> tasks;
+};
+
+static std::shared_mutex pool_mutex;            // Havuzu yeniden boyutlandırmaya karşı korur
+static std::vector<std::unique_ptr<WorkerQueue>> queues;
+static std::vector<std::thread> threads;
+static std::mutex idle_mutex;
+static std::condition_variable idle_cv;
+static std::atomic<int> queued_tasks(0);
+static bool pool_stopping = false;
+static int parallelism = 0;                     // 0: henüz başlatılmadı
+static std::atomic<unsigned> next_queue(0);
+
+static bool pop_task(size_t home, PoolTask& task) {
+    size_t count = queues.size();
+    for (size_t i = 0; i < count; i++) {
+        WorkerQueue& queue = *queues[(home + i) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+            continue;
+        if (i == 0) {
+            task = queue.tasks.back();
+            queue.tasks.pop_back();
+        } else {
+            task = queue.tasks.front();
+            queue.tasks.pop_front();
+        }
+        queued_tasks--;
+        return true;
+    }
+    return false;
+}
+
+static void run_task(const PoolTask& task) {
+    (*task.fn)();
+    std::lock_guard<std::mutex> lock(task.group->mutex);
+    if (--task.group->remaining == 0)
+        task.group->done.notify_all();
+}
+
+static void pool_worker(size_t home) {
+    PoolTask task;
+    while (true) {
+        if (pop_task(home, task)) {
+            run_task(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(idle_mutex);
+        idle_cv.wait(lock, [] { return pool_stopping || queued_tasks > 0; });
+        if (pool_stopping && queued_tasks == 0)
+            return;
+    }
+}
+
+static void stop_workers() {
+    {
+        std::lock_guard<std::mutex> lock(idle_mutex);
+        pool_stopping = true;
+    }
+    idle_cv.notify_all();
+    for (size_t i = 0; i < threads.size(); i++)
+        threads[i].join();
+    threads.clear();
+    queues.clear();
+    pool_stopping = false;
+}
+
+// pool_mutex özel kilitliyken çağrılır. Çağıran iş parçacığı da görev çalıştırdığı
+// için threads - 1 işçi başlatılır.
+static void start_workers(int threads_wanted) {
+    parallelism = threads_wanted;
+    for (int i = 0; i < threads_wanted; i++)
+        queues.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+    for (int i = 1; i < threads_wanted; i++)
+        threads.push_back(std::thread(pool_worker, (size_t)i));
+}
+
+static void shutdown_pool() {
+    std::unique_lock<std::shared_mutex> lock(pool_mutex);
+    stop_workers();
+}
+
+// fs_set_parallelism: Çok dosyalı işlemlerin kullanacağı iş parçacığı sayısını ayarlar
+// (0 veya negatif: tüm çekirdekler, 1: seri çalışma).
+int fs_set_parallelism(int threads_wanted) {
+    static bool atexit_registered = false;
+    if (threads_wanted <= 0)
+        threads_wanted = std::max(1u, std::thread::hardware_concurrency());
+    std::unique_lock<std::shared_mutex> lock(pool_mutex);
+    if (threads_wanted == parallelism)
+        return 0;
+    stop_workers();
+    start_workers(threads_wanted);
+    if (!atexit_registered) {
+        atexit(shutdown_pool);
+        atexit_registered = true;
+    }
+    return 0;
+}
+
+int fs_get_parallelism() {
+    {
+        std::shared_lock<std::shared_mutex> lock(pool_mutex);
+        if (parallelism > 0)
+            return parallelism;
+    }
+    fs_set_parallelism(0);
+    std::shared_lock<std::shared_mutex> lock(pool_mutex);
+    return parallelism;
+}
+
+void fs_parallel_run(const std::vector<std::function<void()>>& tasks) {
+    if (tasks.empty())
+        return;
+    if (fs_get_parallelism() == 1 || tasks.size() == 1) {
+        for (size_t i = 0; i < tasks.size(); i++)
+            tasks[i]();
+        return;
+    }
+    std::shared_lock<std::shared_mutex> pool_lock(pool_mutex);
+    TaskGroup group;
+    group.remaining = (int)tasks.size();
+    size_t count = queues.size();
+    size_t home = next_queue++ % count;
+    for (size_t i = 0; i < tasks.size(); i++) {
+        WorkerQueue& queue = *queues[(home + i) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        PoolTask task = { &tasks[i], &group };
+        queue.tasks.push_back(task);
+        queued_tasks++;
+    }
+    {
+        // Boş kilit: işçi koşulu kontrol edip beklemeye geçerken bildirimin kaybolmasını önler.
+        std::lock_guard<std::mutex> lock(idle_mutex);
+    }
+    idle_cv.notify_all();
+    // Çağıran da görev çalıştırır; iş kalmadığında grubun bitmesini bekler.
+    PoolTask task;
+    while (group.remaining > 0) {
+        if (pop_task(home, task)) {
+            run_task(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(group.mutex);
+        group.done.wait(lock, [&group] { return group.remaining == 0; });
+    }
+    // Son görevi bitiren işçi grubun kilidini bırakmadan grup yok edilmemeli.
+    std::lock_guard<std::mutex> lock(group.mutex);
+}